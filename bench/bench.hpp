@@ -0,0 +1,43 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/latency.hpp"
+
+struct BenchOptions {
+    std::string corpus_dir = "bench/corpora";
+    // Empty runs every suite, the filter keeps benchmarks whose name starts with it
+    std::string suite;
+    std::string filter;
+    unsigned int repeat  = 5;
+    unsigned int threads = 0;
+};
+
+// One measured combination of a benchmark and its input, every field ends up in the JSON report
+struct BenchResult {
+    std::string suite;
+    std::string name;
+    std::string input;
+    uint64_t items = 0;
+    // Total over all repetitions and the fastest single one
+    double seconds  = 0;
+    double best_run = 0;
+    LatencySummary latency;
+    // Suite specific numbers, e.g. search nodes per puzzle
+    std::vector<std::pair<std::string, double>> metrics;
+};
+
+// Solvers over the checked-in corpora
+void runSolverBenchmarks(const BenchOptions &options, std::vector<BenchResult> &results);
+// Conflict checks done on every keypress, on boards from empty to full of conflicts
+void runValidationBenchmarks(const BenchOptions &options, std::vector<BenchResult> &results);
+// Complete grids: the relabeling kernels alone and whole packed batches
+void runGeneratorBenchmarks(const BenchOptions &options, std::vector<BenchResult> &results);
+// Loading puzzles: parsing the text corpora against decoding them from an archive
+void runIoBenchmarks(const BenchOptions &options, std::vector<BenchResult> &results);
+
+#endif // BENCH_HPP
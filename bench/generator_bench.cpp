@@ -0,0 +1,120 @@
+#include <chrono>
+
+#include "bench.hpp"
+#include "core/cpu_features.hpp"
+#include "core/grid_generator.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr unsigned int BATCH_SIZE = 256;
+static constexpr unsigned int BATCHES    = 2000;
+
+// Keeps the compiler from dropping the measured calls
+static volatile uint64_t sink;
+
+static BenchResult makeResult(const std::string &name, const char *input) {
+    BenchResult result;
+    result.suite = "generator";
+    result.name  = name;
+    result.input = input;
+    return result;
+}
+
+// Whole batches on the pool, every latency sample is the average time per grid of one run
+static BenchResult measureBatch(const GridGenerator &generator,
+                                ThreadPool &pool,
+                                bool independent,
+                                size_t count,
+                                unsigned int repeat) {
+    BenchResult result = makeResult(independent ? "grids_independent" : "grids_pooled", "random");
+    std::vector<PackedBoard> grids(count);
+
+    std::vector<uint64_t> latencies;
+    for (unsigned int run = 0; run < repeat; run++) {
+        const auto start = Clock::now();
+        generator.generate(pool, run, independent, grids.data(), count);
+
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        result.best_run      = run == 0 ? seconds : std::min(result.best_run, seconds);
+        result.seconds += seconds;
+        latencies.push_back(seconds * 1e9 / count);
+    }
+
+    sink           = grids[count - 1].digits[0];
+    result.items   = count;
+    result.latency = summarizeLatencies(latencies);
+    result.metrics = {
+        {"threads", pool.getThreadCount()},
+    };
+    return result;
+}
+
+void runGeneratorBenchmarks(const BenchOptions &options, std::vector<BenchResult> &results) {
+    const auto selected = [&](const std::string &name) {
+        return options.filter.empty() || name.starts_with(options.filter);
+    };
+
+    using TransformKernel = void (*)(const SeedGrid &, const GridTransform &, Cells &);
+    const std::pair<SimdLevel, TransformKernel> transform_kernels[] = {
+        {SIMD_SCALAR, transformGridScalar},
+        {SIMD_SSE42,  transformGridSse42 },
+    };
+
+    const GridGenerator generator(2024);
+
+    // The relabeling alone, with the transforms drawn up front
+    Random random(7);
+    std::vector<GridTransform> transforms(BATCH_SIZE);
+    for (GridTransform &transform : transforms) {
+        GridGenerator::randomTransform(random, transform);
+    }
+
+    PackedBoard packed;
+    Cells grid;
+    generator.generate(random, &packed, 1);
+    unpackCells(packed, grid);
+    SeedGrid seed;
+    GridGenerator::makeSeedGrid(grid, seed);
+
+    for (const auto &[level, kernel] : transform_kernels) {
+        const std::string name = std::string("transform_grid_") + getSimdLevelName(level);
+        if (level > detectSimdLevel() || !selected(name)) { continue; }
+
+        BenchResult result = makeResult(name, "seed");
+        std::vector<uint64_t> latencies;
+        uint64_t total = 0;
+        for (unsigned int run = 0; run < options.repeat; run++) {
+            const auto run_start = Clock::now();
+            for (unsigned int batch = 0; batch < BATCHES; batch++) {
+                const auto start = Clock::now();
+                for (const GridTransform &transform : transforms) {
+                    kernel(seed, transform, grid);
+                    total += grid[80];
+                }
+
+                const auto elapsed = Clock::now() - start;
+                latencies.push_back(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()
+                    / BATCH_SIZE);
+            }
+
+            const double seconds = std::chrono::duration<double>(Clock::now() - run_start).count();
+            result.best_run      = run == 0 ? seconds : std::min(result.best_run, seconds);
+            result.seconds += seconds;
+        }
+
+        sink           = total;
+        result.items   = uint64_t(BATCHES) * BATCH_SIZE;
+        result.latency = summarizeLatencies(latencies);
+        results.push_back(result);
+    }
+
+    // Complete packed grids, the relabeling of a pooled seed against a new seed per grid
+    ThreadPool pool(options.threads);
+    if (selected("grids_pooled")) {
+        results.push_back(measureBatch(generator, pool, false, 1 << 22, options.repeat));
+    }
+    if (selected("grids_independent")) {
+        results.push_back(measureBatch(generator, pool, true, 1 << 15, options.repeat));
+    }
+}
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include "bench.hpp"
+#include "core/archive.hpp"
+#include "core/puzzle_reader.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr const char *CORPORA[] = {"easy", "hard", "17-clue", "pathological"};
+
+// The corpora are small, every run goes over them this often
+static constexpr size_t PUZZLES_PER_RUN = 1 << 18;
+
+// Keeps the compiler from dropping the measured calls
+static volatile uint64_t sink;
+
+static bool readFile(const std::string &path, std::string &data) {
+    std::ifstream input(path, std::ios::binary);
+    data.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    return bool(input) || input.eof();
+}
+
+// Times whole passes over the corpus, every latency sample is the average time per puzzle of
+// one pass. `decode(puzzles)` fills `puzzles` from the stored form.
+template <typename Decode>
+static BenchResult measure(const char *name,
+                           const char *corpus,
+                           size_t count,
+                           double bytes,
+                           unsigned int repeat,
+                           Decode decode) {
+    BenchResult result;
+    result.suite = "io";
+    result.name  = name;
+    result.input = corpus;
+
+    std::vector<PackedBoard> puzzles;
+    decode(puzzles);
+
+    const size_t passes = std::max<size_t>(1, PUZZLES_PER_RUN / std::max<size_t>(1, count));
+    std::vector<uint64_t> latencies;
+    for (unsigned int run = 0; run < repeat; run++) {
+        const auto run_start = Clock::now();
+        for (size_t pass = 0; pass < passes; pass++) {
+            const auto start = Clock::now();
+            decode(puzzles);
+
+            const auto elapsed = Clock::now() - start;
+            latencies.push_back(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()
+                / std::max<size_t>(1, count));
+        }
+
+        const double seconds = std::chrono::duration<double>(Clock::now() - run_start).count();
+        result.best_run      = run == 0 ? seconds : std::min(result.best_run, seconds);
+        result.seconds += seconds;
+    }
+
+    sink           = puzzles.empty() ? 0 : puzzles.back().digits[0];
+    result.items   = count * passes;
+    result.latency = summarizeLatencies(latencies);
+    result.metrics = {
+        {"bytes_per_puzzle", bytes / std::max<size_t>(1, count)},
+    };
+    return result;
+}
+
+void runIoBenchmarks(const BenchOptions &options, std::vector<BenchResult> &results) {
+    const auto selected = [&](const char *name) {
+        return options.filter.empty() || std::string(name).starts_with(options.filter);
+    };
+
+    const std::string archive_path =
+        (std::filesystem::temp_directory_path() / "sudoku_bench.sdz").string();
+
+    for (const char *corpus : CORPORA) {
+        std::string text;
+        if (!readFile(options.corpus_dir + "/" + corpus + ".txt", text)) { continue; }
+
+        // The text reader parses straight out of memory, so neither side pays for the disk
+        PuzzleReader reader;
+        const auto read_text = [&](std::vector<PackedBoard> &puzzles) {
+            reader.openBuffer(text.data(), text.size());
+
+            puzzles.clear();
+            Cells cells;
+            ReadStatus status;
+            while ((status = reader.next(cells)) != READ_END) {
+                if (status == READ_OK) { packCells(cells, puzzles.emplace_back()); }
+            }
+        };
+
+        std::vector<PackedBoard> puzzles;
+        read_text(puzzles);
+
+        if (selected("text_reader")) {
+            results.push_back(measure(
+                "text_reader", corpus, puzzles.size(), text.size(), options.repeat, read_text));
+        }
+
+        // Block by block on one thread, the same work as the reader
+        Archive archive;
+        if (selected("archive_decode") && Archive::write(archive_path.c_str(), puzzles)
+            && archive.open(archive_path.c_str())) {
+            const auto decode_archive = [&](std::vector<PackedBoard> &decoded) {
+                decoded.resize(archive.getCount());
+                std::vector<PackedBoard> block_puzzles;
+                for (size_t block = 0; block < archive.getBlockCount(); block++) {
+                    archive.decodeBlock(block, block_puzzles);
+                    std::copy(block_puzzles.begin(),
+                              block_puzzles.end(),
+                              decoded.begin() + block * archive.getBlockSize());
+                }
+            };
+
+            results.push_back(measure("archive_decode",
+                                      corpus,
+                                      puzzles.size(),
+                                      std::filesystem::file_size(archive_path),
+                                      options.repeat,
+                                      decode_archive));
+            archive.close();
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::remove(archive_path, error);
+}
@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "bench.hpp"
+#include "core/cpu_features.hpp"
+#include "core/kernels.hpp"
+
+static void printUsage() {
+    std::cerr << "Usage: SudokuBench [--suite solver|validation|generator|io] [--corpora dir] "
+                 "[--filter name] [--repeat count] [--threads count] [--json path]"
+              << std::endl;
+}
+
+static void printResults(const std::vector<BenchResult> &results) {
+    std::printf("%-12s %-22s %-14s %12s %10s %10s %10s\n",
+                "suite",
+                "name",
+                "input",
+                "best items/s",
+                "p50 ns",
+                "p99 ns",
+                "p99.9 ns");
+    for (const BenchResult &result : results) {
+        std::printf("%-12s %-22s %-14s %12.0f %10llu %10llu %10llu\n",
+                    result.suite.c_str(),
+                    result.name.c_str(),
+                    result.input.c_str(),
+                    result.items / result.best_run,
+                    (unsigned long long)result.latency.p50,
+                    (unsigned long long)result.latency.p99,
+                    (unsigned long long)result.latency.p999);
+    }
+}
+
+// Names are plain identifiers, only quotes and backslashes need escaping
+static void writeString(std::ostream &output, const std::string &value) {
+    output << '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') { output << '\\'; }
+        output << c;
+    }
+    output << '"';
+}
+
+static bool writeJson(const char *path,
+                      const BenchOptions &options,
+                      const std::vector<BenchResult> &results) {
+    std::ofstream output(path);
+    output.precision(9);
+
+    output << "{\n  \"host\": {\"simd\": ";
+    writeString(output, getSimdLevelName(Kernels::get().level));
+    output << ", \"hardware_threads\": " << std::thread::hardware_concurrency() << "},\n";
+    output << "  \"options\": {\"repeat\": " << options.repeat
+           << ", \"threads\": " << options.threads << "},\n";
+
+    output << "  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult &result = results[i];
+        output << (i == 0 ? "\n" : ",\n") << "    {\"suite\": ";
+        writeString(output, result.suite);
+        output << ", \"name\": ";
+        writeString(output, result.name);
+        output << ", \"input\": ";
+        writeString(output, result.input);
+        output << ", \"items\": " << result.items << ", \"seconds\": " << result.seconds
+               << ", \"items_per_second\": " << result.items * options.repeat / result.seconds
+               << ", \"best_items_per_second\": " << result.items / result.best_run;
+
+        const LatencySummary &latency = result.latency;
+        output << ", \"latency_ns\": {\"mean\": " << latency.mean << ", \"p50\": " << latency.p50
+               << ", \"p90\": " << latency.p90 << ", \"p99\": " << latency.p99
+               << ", \"p999\": " << latency.p999 << ", \"max\": " << latency.max << "}";
+
+        for (const auto &[name, value] : result.metrics) {
+            output << ", ";
+            writeString(output, name);
+            output << ": " << value;
+        }
+        output << "}";
+    }
+    output << "\n  ]\n}\n";
+
+    if (!output) {
+        std::cerr << "Failed to write benchmark results to '" << path << "'" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char **argv) {
+    BenchOptions options;
+    const char *json_path = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 == argc) {
+            printUsage();
+            return -1;
+        }
+
+        if (std::strcmp(argv[i], "--suite") == 0) {
+            options.suite = argv[++i];
+        } else if (std::strcmp(argv[i], "--corpora") == 0) {
+            options.corpus_dir = argv[++i];
+        } else if (std::strcmp(argv[i], "--filter") == 0) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--repeat") == 0) {
+            options.repeat = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--threads") == 0) {
+            options.threads = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            json_path = argv[++i];
+        } else {
+            printUsage();
+            return -1;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    if (options.suite.empty() || options.suite == "solver") {
+        runSolverBenchmarks(options, results);
+    }
+    if (options.suite.empty() || options.suite == "validation") {
+        runValidationBenchmarks(options, results);
+    }
+    if (options.suite.empty() || options.suite == "generator") {
+        runGeneratorBenchmarks(options, results);
+    }
+    if (options.suite.empty() || options.suite == "io") {
+        runIoBenchmarks(options, results);
+    }
+
+    if (results.empty()) {
+        std::cerr << "Failed to run benchmarks: nothing matched the suite and filter" << std::endl;
+        return -1;
+    }
+
+    printResults(results);
+    if (json_path && !writeJson(json_path, options, results)) { return -1; }
+
+    return 0;
+}
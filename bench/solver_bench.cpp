@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include "bench.hpp"
+#include "core/batch_solver.hpp"
+#include "core/dancing_links.hpp"
+#include "core/logical_solver.hpp"
+#include "core/parallel_solver.hpp"
+#include "core/puzzle_reader.hpp"
+#include "core/solver.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr const char *CORPORA[] = {"easy", "hard", "17-clue", "pathological"};
+
+static bool loadCorpus(const std::string &path, std::vector<Cells> &puzzles) {
+    PuzzleReader reader;
+    if (!reader.open(path.c_str())) { return false; }
+
+    Cells cells;
+    ReadStatus status;
+    while ((status = reader.next(cells)) != READ_END) {
+        if (status == READ_OK) { puzzles.push_back(cells); }
+    }
+
+    return true;
+}
+
+// Times every puzzle on its own with a single solver instance. `solve(puzzle)` returns whether
+// the puzzle was solved and adds to `stats`.
+template <typename Solve>
+static BenchResult measure(const char *name,
+                           const char *corpus,
+                           const std::vector<Cells> &puzzles,
+                           unsigned int repeat,
+                           Solve solve) {
+    BenchResult result;
+    result.suite = "solver";
+    result.name  = name;
+    result.input = corpus;
+
+    // The first pass only warms up caches and branch predictors
+    SolverStats stats;
+    for (const Cells &puzzle : puzzles) { solve(puzzle, stats); }
+
+    stats = {};
+    std::vector<uint64_t> latencies;
+    latencies.reserve(puzzles.size() * repeat);
+    uint64_t solved = 0;
+    for (unsigned int run = 0; run < repeat; run++) {
+        const auto run_start = Clock::now();
+        for (const Cells &puzzle : puzzles) {
+            const auto start = Clock::now();
+            solved += solve(puzzle, stats);
+            latencies.push_back(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        }
+
+        const double seconds = std::chrono::duration<double>(Clock::now() - run_start).count();
+        result.best_run      = run == 0 ? seconds : std::min(result.best_run, seconds);
+        result.seconds += seconds;
+    }
+
+    const double count = double(puzzles.size()) * repeat;
+    result.items       = puzzles.size();
+    result.latency     = summarizeLatencies(latencies);
+    result.metrics     = {
+        {"solved_fraction",       solved / count          },
+        {"nodes_per_puzzle",      stats.nodes / count     },
+        {"backtracks_per_puzzle", stats.backtracks / count},
+    };
+    return result;
+}
+
+// Throughput of the whole batch on all threads, latencies are per puzzle as seen by a worker
+static BenchResult measureBatch(const char *corpus,
+                                const std::vector<Cells> &puzzles,
+                                unsigned int repeat,
+                                unsigned int threads) {
+    BenchResult result;
+    result.suite = "solver";
+    result.name  = "batch";
+    result.input = corpus;
+
+    BatchSolver solver(threads);
+    std::vector<PackedBoard> packed(puzzles.size()), solutions;
+    for (size_t i = 0; i < puzzles.size(); i++) { packCells(puzzles[i], packed[i]); }
+    solver.solve(packed, solutions);
+
+    std::vector<uint64_t> latencies, all_latencies;
+    uint64_t solved = 0;
+    for (unsigned int run = 0; run < repeat; run++) {
+        const auto run_start = Clock::now();
+        solved += solver.solve(packed, solutions, latencies);
+
+        const double seconds = std::chrono::duration<double>(Clock::now() - run_start).count();
+        result.best_run      = run == 0 ? seconds : std::min(result.best_run, seconds);
+        result.seconds += seconds;
+        all_latencies.insert(all_latencies.end(), latencies.begin(), latencies.end());
+    }
+
+    result.items   = puzzles.size();
+    result.latency = summarizeLatencies(all_latencies);
+    result.metrics = {
+        {"solved_fraction", solved / (double(puzzles.size()) * repeat)},
+        {"threads",         double(solver.getPool().getThreadCount()) },
+    };
+    return result;
+}
+
+void runSolverBenchmarks(const BenchOptions &options, std::vector<BenchResult> &results) {
+    Solver<3, 3> backtracking;
+    DancingLinks dancing_links;
+    LogicalSolver logical;
+    ThreadPool pool(options.threads);
+    ParallelSolver parallel(pool);
+
+    for (const char *corpus : CORPORA) {
+        std::vector<Cells> puzzles;
+        if (!loadCorpus(options.corpus_dir + "/" + corpus + ".txt", puzzles)) { continue; }
+
+        const auto selected = [&](const char *name) {
+            return options.filter.empty() || std::string(name).starts_with(options.filter);
+        };
+
+        const auto solve_backtracking = [&](const Cells &puzzle, SolverStats &stats) {
+            const bool solved = backtracking.solve(puzzle);
+            stats.nodes += backtracking.getStats().nodes;
+            stats.backtracks += backtracking.getStats().backtracks;
+            return solved;
+        };
+
+        const auto solve_dancing_links = [&](const Cells &puzzle, SolverStats &stats) {
+            const bool solved = dancing_links.countSolutions(puzzle, 1) == 1;
+            stats.nodes += dancing_links.getStats().nodes;
+            stats.backtracks += dancing_links.getStats().backtracks;
+            return solved;
+        };
+
+        if (selected("backtracking")) {
+            results.push_back(
+                measure("backtracking", corpus, puzzles, options.repeat, solve_backtracking));
+        }
+
+        if (selected("dancing_links")) {
+            results.push_back(
+                measure("dancing_links", corpus, puzzles, options.repeat, solve_dancing_links));
+        }
+
+        // Logical steps count as nodes, the solver never backtracks. Puzzles that need harder
+        // techniques than it knows stay unsolved.
+        const auto solve_logical = [&](const Cells &puzzle, SolverStats &stats) {
+            const bool solved = logical.solve(puzzle);
+            stats.nodes += logical.getSteps().size();
+            return solved;
+        };
+
+        if (selected("logical")) {
+            logical.resetStats();
+            BenchResult result = measure("logical", corpus, puzzles, options.repeat, solve_logical);
+
+            // Where the time goes, the warm-up pass included
+            const double solves = double(puzzles.size()) * (options.repeat + 1);
+            for (unsigned int i = 0; i < TECHNIQUE_COUNT; i++) {
+                const std::string name      = getTechniqueName(Technique(i));
+                const TechniqueStats &stats = logical.getStats()[i];
+                result.metrics.push_back({name + "_ns_per_puzzle", stats.nanoseconds / solves});
+                result.metrics.push_back({name + "_uses_per_puzzle", stats.applications / solves});
+            }
+            results.push_back(result);
+        }
+
+        // One puzzle at a time split across all threads, only worth it on the slow ones. The
+        // speedup is against `backtracking` on the same corpus.
+        const auto solve_parallel = [&](const Cells &puzzle, SolverStats &stats) {
+            const bool solved = parallel.solve(puzzle);
+            stats.nodes += parallel.getStats().nodes;
+            stats.backtracks += parallel.getStats().backtracks;
+            return solved;
+        };
+
+        if (selected("parallel") && std::string(corpus) == "pathological") {
+            BenchResult result =
+                measure("parallel", corpus, puzzles, options.repeat, solve_parallel);
+            result.metrics.push_back({"threads", double(pool.getThreadCount())});
+            results.push_back(result);
+        }
+
+        if (selected("batch")) {
+            results.push_back(measureBatch(corpus, puzzles, options.repeat, options.threads));
+        }
+    }
+}
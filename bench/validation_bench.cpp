@@ -0,0 +1,153 @@
+#include <chrono>
+#include <random>
+
+#include "bench.hpp"
+#include "core/board.hpp"
+#include "core/builtin_puzzles.hpp"
+#include "core/cpu_features.hpp"
+#include "core/validation.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+// A single call takes nanoseconds, which is below what the clock can resolve, so every latency
+// sample is the average over a batch of calls
+static constexpr unsigned int BATCH_SIZE = 256;
+static constexpr unsigned int BATCHES    = 2000;
+
+// Keeps the compiler from dropping the measured calls
+static volatile uint64_t sink;
+
+struct BoardInput {
+    const char *name;
+    Cells cells;
+};
+
+// Boards that cover the cheap and the expensive end of every check: nothing to compare, a
+// normal game, a board one keypress away from done and a board full of duplicates
+static std::vector<BoardInput> makeInputs() {
+    std::mt19937 random(2024);
+    const Cells &solution = getBuiltinPuzzle(0).solution;
+
+    std::vector<BoardInput> inputs = {
+        {"empty",       {}      },
+        {"random",      solution},
+        {"nearly_full", solution},
+        {"conflicting", {}      },
+    };
+
+    for (unsigned int i = 0; i < 81 - 30; i++) { inputs[1].cells[random() % 81] = 0; }
+    for (unsigned int i = 0; i < 5; i++) { inputs[2].cells[random() % 81] = 0; }
+    for (uint8_t &cell : inputs[3].cells) { cell = random() % 9 + 1; }
+    return inputs;
+}
+
+// Runs `call(i)` in batches and records the average time per call of every batch
+template <typename Call>
+static BenchResult measure(const char *name,
+                           const char *input,
+                           unsigned int repeat,
+                           Call call) {
+    BenchResult result;
+    result.suite = "validation";
+    result.name  = name;
+    result.input = input;
+
+    uint64_t total = 0;
+    for (unsigned int i = 0; i < BATCH_SIZE * 16; i++) { total += call(i); }
+
+    std::vector<uint64_t> latencies;
+    latencies.reserve(BATCHES * repeat);
+    for (unsigned int run = 0; run < repeat; run++) {
+        const auto run_start = Clock::now();
+        for (unsigned int batch = 0; batch < BATCHES; batch++) {
+            const auto start = Clock::now();
+            for (unsigned int i = 0; i < BATCH_SIZE; i++) { total += call(batch * BATCH_SIZE + i); }
+
+            const auto elapsed = Clock::now() - start;
+            latencies.push_back(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / BATCH_SIZE);
+        }
+
+        const double seconds = std::chrono::duration<double>(Clock::now() - run_start).count();
+        result.best_run      = run == 0 ? seconds : std::min(result.best_run, seconds);
+        result.seconds += seconds;
+    }
+
+    sink           = total;
+    result.items   = uint64_t(BATCHES) * BATCH_SIZE;
+    result.latency = summarizeLatencies(latencies);
+    result.metrics = {
+        {"batch_size", BATCH_SIZE},
+    };
+    return result;
+}
+
+void runValidationBenchmarks(const BenchOptions &options, std::vector<BenchResult> &results) {
+    const auto selected = [&](const std::string &name) {
+        return options.filter.empty() || name.starts_with(options.filter);
+    };
+
+    using ScanKernel = void (*)(const Cells &, UnitConflicts &);
+    const std::pair<SimdLevel, ScanKernel> scan_kernels[] = {
+        {SIMD_SCALAR, findConflictsScalar},
+        {SIMD_SSE42,  findConflictsSse42 },
+        {SIMD_AVX2,   findConflictsAvx2  },
+        {SIMD_AVX512, findConflictsAvx512},
+    };
+
+    // Keypresses cycle over every cell and digit, including erasing
+    std::vector<std::pair<uint8_t, uint8_t>> keys;
+    std::mt19937 random(7);
+    for (unsigned int i = 0; i < 4096; i++) { keys.push_back({random() % 81, random() % 10}); }
+
+    for (const BoardInput &input : makeInputs()) {
+        Board<3, 3> board;
+        for (unsigned int i = 0; i < 81; i++) { board.set(i, input.cells[i]); }
+
+        // A keypress: the incremental update of the digit counts and conflicts, then the board is
+        // put back so every call starts from the same state
+        if (selected("set")) {
+            results.push_back(measure("set", input.name, options.repeat, [&](unsigned int i) {
+                const auto [index, digit] = keys[i % keys.size()];
+                board.set(index, digit);
+                board.set(index, input.cells[index]);
+                return board.getErrorCount();
+            }));
+        }
+
+        // What the renderer asks for after every keypress
+        if (selected("unit_conflicts")) {
+            results.push_back(
+                measure("unit_conflicts", input.name, options.repeat, [&](unsigned int i) {
+                    return board.getConflicts(i % 27);
+                }));
+        }
+
+        if (selected("conflict_cells")) {
+            results.push_back(
+                measure("conflict_cells", input.name, options.repeat, [&](unsigned int) {
+                    return board.getConflictCells().count();
+                }));
+        }
+
+        if (selected("clashes")) {
+            results.push_back(measure("clashes", input.name, options.repeat, [&](unsigned int i) {
+                return board.getClashes(i % 81).count();
+            }));
+        }
+
+        // Full scans of all 27 units, the stateless equivalent of checking every row, column
+        // and box from scratch
+        for (const auto &[level, kernel] : scan_kernels) {
+            const std::string name = std::string("find_conflicts_") + getSimdLevelName(level);
+            if (level > detectSimdLevel() || !selected(name)) { continue; }
+
+            UnitConflicts conflicts;
+            results.push_back(
+                measure(name.c_str(), input.name, options.repeat, [&](unsigned int) {
+                    kernel(input.cells, conflicts);
+                    return conflicts[0];
+                }));
+        }
+    }
+}
@@ -7,6 +7,36 @@ workspace "Sudoku"
   platforms { "Linux", "Windows" }
   architecture "x86_64"
 
+  filter "configurations:Debug"
+    defines { "DEBUG" }
+    symbols "On"
+
+  filter "configurations:OptimizedDebug"
+    defines { "DEBUG" }
+    optimize "On"
+    symbols "On"
+
+  filter "configurations:Release"
+    defines { "NDEBUG" }
+    optimize "On"
+
+  filter {}
+
+project "libsudoku"
+  kind "StaticLib"
+  language "C++"
+  targetdir "bin/%{cfg.buildcfg}"
+  targetname "sudoku"
+  buildoptions { "-Wall", "-Wextra", "-Wpedantic" }
+
+  files { "src/core/**.hpp", "src/core/**.cpp" }
+
+  -- Built-in puzzles are solved at compile time
+  filter "toolset:clang"
+    buildoptions { "-fconstexpr-steps=16777216" }
+
+  filter {}
+
 project "Sudoku"
   kind "WindowedApp"
   language "C++"
@@ -15,9 +45,10 @@ project "Sudoku"
 
   externalincludedirs { "lib/glad/include", "lib/glm", "/usr/include/freetype2" }
 
-  links { "glfw", "freetype" }
+  links { "libsudoku", "glfw", "freetype" }
 
   files { "src/**.hpp", "src/**.cpp", "lib/glad/src/glad.c" }
+  removefiles { "src/core/**" }
 
   filter "platforms:Linux"
       libdirs { "/usr/lib" }
@@ -25,15 +56,17 @@ project "Sudoku"
   filter "platforms:Windows"
       libdirs { "" }
 
-  filter "configurations:Debug"
-    defines { "DEBUG" }
-    symbols "On"
+project "SudokuBench"
+  kind "ConsoleApp"
+  language "C++"
+  targetdir "bin/%{cfg.buildcfg}"
+  buildoptions { "-Wall", "-Wextra", "-Wpedantic" }
 
-  filter "configurations:OptimizedDebug"
-    defines { "DEBUG" }
-    optimize "On"
-    symbols "On"
+  includedirs { "src" }
 
-  filter "configurations:Release"
-    defines { "NDEBUG" }
-    optimize "On"
+  links { "libsudoku" }
+
+  files { "bench/**.hpp", "bench/**.cpp" }
+
+  filter "platforms:Linux"
+      links { "pthread" }
@@ -0,0 +1,420 @@
+#include "archive.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+
+#include "tables.hpp"
+
+// Pattern with the columns of a row mirrored
+static constexpr std::array<uint16_t, 512> MIRRORED_PATTERNS = [] {
+    std::array<uint16_t, 512> result = {};
+    for (unsigned int pattern = 0; pattern < 512; pattern++) {
+        for (unsigned int column = 0; column < 9; column++) {
+            if (pattern & (1 << column)) { result[pattern] |= 1 << (8 - column); }
+        }
+    }
+    return result;
+}();
+
+// Index of the `rank`th set bit of every 9-bit mask
+static constexpr std::array<std::array<uint8_t, 9>, 512> SELECT_BIT = [] {
+    std::array<std::array<uint8_t, 9>, 512> result = {};
+    for (unsigned int mask = 0; mask < 512; mask++) {
+        unsigned int rank = 0;
+        for (unsigned int bit = 0; bit < 9; bit++) {
+            if (mask & (1 << bit)) { result[mask][rank++] = bit; }
+        }
+    }
+    return result;
+}();
+
+// Rank models are stored for clues with 2 to 9 allowed digits
+static constexpr unsigned int FIRST_RANK_MODEL = 2;
+static constexpr uint64_t TABLES_SIZE          = 2 * sizeof(RowModel::freqs)
+                                      + (10 - FIRST_RANK_MODEL) * sizeof(RankModel::freqs);
+
+// Model of the clue pattern of `row` and the value coded for it: upper rows as they are, lower
+// rows relative to the mirrored pattern of the row opposite to them
+static inline unsigned int patternModel(unsigned int row) { return row < 5 ? 0 : 1; }
+
+static inline unsigned int patternValue(const std::array<uint16_t, 9> &patterns,
+                                        unsigned int row) {
+    return row < 5 ? patterns[row] : patterns[row] ^ MIRRORED_PATTERNS[patterns[8 - row]];
+}
+
+// Walks the symbols of a puzzle in the order they are decoded. `pattern(model, value)` gets
+// every row pattern and `rank(rank, count)` every clue with more than one allowed digit.
+// Returns false when a clue conflicts with an earlier one.
+template <typename PatternCallback, typename RankCallback>
+static bool walkPuzzle(const Cells &cells, PatternCallback pattern, RankCallback rank) {
+    std::array<uint16_t, 9> patterns = {};
+    std::array<uint16_t, 3 * 9> used = {};
+    for (unsigned int row = 0; row < 9; row++) {
+        for (unsigned int column = 0; column < 9; column++) {
+            if (cells[row * 9 + column] != 0) { patterns[row] |= 1 << column; }
+        }
+        pattern(patternModel(row), patternValue(patterns, row));
+
+        for (unsigned int column = 0; column < 9; column++) {
+            const unsigned int cell = row * 9 + column;
+            if (cells[cell] == 0) { continue; }
+
+            const auto &units         = CELL_UNITS[cell];
+            const uint16_t candidates = ~(used[units[0]] | used[units[1]] | used[units[2]]) & 0x1FF;
+            const uint16_t bit        = (1 << cells[cell]) >> 1;
+            if (!(candidates & bit)) { return false; }
+
+            const unsigned int count = std::popcount(candidates);
+            if (count > 1) { rank(std::popcount(uint16_t(candidates & (bit - 1))), count); }
+
+            used[units[0]] |= bit;
+            used[units[1]] |= bit;
+            used[units[2]] |= bit;
+        }
+    }
+
+    return true;
+}
+
+// Scales symbol counts to frequencies summing to `RANS_TOTAL`, every seen symbol keeps at least 1
+template <size_t N>
+static void normalizeFrequencies(const std::array<uint64_t, N> &counts,
+                                 std::array<uint16_t, N> &freqs) {
+    freqs              = {};
+    const uint64_t sum = std::accumulate(counts.begin(), counts.end(), uint64_t(0));
+    if (sum == 0) { return; }
+
+    uint32_t assigned = 0;
+    for (unsigned int i = 0; i < N; i++) {
+        if (counts[i] == 0) { continue; }
+
+        freqs[i] = std::max<uint64_t>(1, counts[i] * RANS_TOTAL / sum);
+        assigned += freqs[i];
+    }
+
+    // The most frequent symbols absorb the rounding error
+    std::array<uint16_t, N> order;
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](uint16_t a, uint16_t b) {
+        return freqs[a] > freqs[b];
+    });
+
+    if (assigned < RANS_TOTAL) { freqs[order[0]] += RANS_TOTAL - assigned; }
+    for (unsigned int i = 0; i < N && assigned > RANS_TOTAL; i++) {
+        const uint32_t taken = std::min<uint32_t>(assigned - RANS_TOTAL, freqs[order[i]] - 1);
+        freqs[order[i]] -= taken;
+        assigned -= taken;
+    }
+}
+
+// Fills the starts and the slot table of `model` from its frequencies. Returns false unless
+// they add up to `RANS_TOTAL`.
+static bool buildRowModel(RowModel &model) {
+    uint32_t start = 0;
+    for (unsigned int pattern = 0; pattern < 512; pattern++) {
+        model.starts[pattern] = start;
+        if (start + model.freqs[pattern] > RANS_TOTAL) { return false; }
+
+        std::fill_n(&model.patterns[start], model.freqs[pattern], pattern);
+        start += model.freqs[pattern];
+    }
+
+    return start == RANS_TOTAL;
+}
+
+// Same for the ranks of a clue with `count` allowed digits, ranks from `count` on must be unused
+static bool buildRankModel(RankModel &model, unsigned int count) {
+    uint32_t start = 0;
+    for (unsigned int rank = 0; rank < 9; rank++) {
+        model.starts[rank] = start;
+        if ((rank >= count && model.freqs[rank] != 0) || start + model.freqs[rank] > RANS_TOTAL) {
+            return false;
+        }
+
+        start += model.freqs[rank];
+    }
+    model.starts[9] = start;
+    if (start != RANS_TOTAL) { return false; }
+
+    unsigned int rank = 0;
+    for (unsigned int i = 0; i < model.ranks.size(); i++) {
+        while ((i << RankModel::LOOKUP_SHIFT) >= model.starts[rank + 1]) { rank++; }
+        model.ranks[i] = rank;
+    }
+
+    return true;
+}
+
+bool Archive::open(const char *path) {
+    this->close();
+    if (!this->file.open(path)) { return false; }
+
+    const char *data            = this->file.getData();
+    const size_t size           = this->file.getSize();
+    const ArchiveHeader *header = (const ArchiveHeader *)data;
+    if (size < sizeof(ArchiveHeader) || std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << "Failed to read archive '" << path << "': not an archive file" << std::endl;
+        this->close();
+        return false;
+    }
+
+    if (header->version != VERSION) {
+        std::cerr << "Failed to read archive '" << path << "': unsupported version "
+                  << header->version << std::endl;
+        this->close();
+        return false;
+    }
+
+    const uint64_t blocks      = header->block_size == 0
+                                   ? 0
+                                   : (header->count + header->block_size - 1) / header->block_size;
+    bool valid = header->block_size != 0 && header->block_count == blocks
+              && header->tables_offset % 8 == 0 && header->tables_offset <= size
+              && size - header->tables_offset >= TABLES_SIZE && header->index_offset % 8 == 0
+              && header->index_offset <= size
+              && header->block_count < (size - header->index_offset) / sizeof(uint64_t);
+
+    // Blocks must follow each other between the tables and the index
+    const uint64_t *index = (const uint64_t *)(data + header->index_offset);
+    for (uint64_t block = 0; valid && block <= header->block_count; block++) {
+        const uint64_t begin = block == 0 ? header->tables_offset + TABLES_SIZE : index[block - 1];
+        valid = index[block] >= begin && index[block] <= header->index_offset;
+    }
+
+    for (unsigned int model = 0; valid && model < 2; model++) {
+        std::memcpy(this->rows[model].freqs.data(),
+                    data + header->tables_offset + model * sizeof(RowModel::freqs),
+                    sizeof(RowModel::freqs));
+        valid = buildRowModel(this->rows[model]) || header->count == 0;
+    }
+
+    const char *rank_tables = data + header->tables_offset + 2 * sizeof(RowModel::freqs);
+    for (unsigned int count = FIRST_RANK_MODEL; valid && count <= 9; count++) {
+        RankModel &model = this->ranks[count];
+        std::memcpy(model.freqs.data(),
+                    rank_tables + (count - FIRST_RANK_MODEL) * sizeof(RankModel::freqs),
+                    sizeof(RankModel::freqs));
+        valid = buildRankModel(model, count);
+    }
+
+    if (!valid) {
+        std::cerr << "Failed to read archive '" << path << "': corrupt tables or block index"
+                  << std::endl;
+        this->close();
+        return false;
+    }
+
+    this->header = header;
+    this->index  = index;
+    return true;
+}
+
+void Archive::close() {
+    this->file.close();
+
+    this->header = nullptr;
+    this->index  = nullptr;
+}
+
+size_t Archive::getCount() const { return this->header ? this->header->count : 0; }
+
+size_t Archive::getBlockCount() const { return this->header ? this->header->block_count : 0; }
+
+size_t Archive::getBlockSize() const { return this->header ? this->header->block_size : 0; }
+
+bool Archive::getPuzzle(size_t index, Cells &cells) const {
+    if (index >= this->getCount()) { return false; }
+
+    const size_t block  = index / this->header->block_size;
+    const uint8_t *data = (const uint8_t *)this->file.getData() + this->index[block];
+
+    RansDecoder decoder(data, this->index[block + 1] - this->index[block]);
+    for (size_t i = block * this->header->block_size; i <= index; i++) {
+        if (!this->decodePuzzle(decoder, cells)) {
+            cells = {};
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Archive::decodeBlock(size_t block, std::vector<PackedBoard> &puzzles) const {
+    puzzles.resize(this->getBlockPuzzleCount(block));
+    this->decodeBlock(block, puzzles.size(), puzzles.data());
+}
+
+void Archive::decodeAll(ThreadPool &pool, std::vector<PackedBoard> &puzzles) const {
+    puzzles.resize(this->getCount());
+    pool.parallelFor(this->getBlockCount(), 1, [&](size_t begin, size_t end) {
+        for (size_t block = begin; block < end; block++) {
+            this->decodeBlock(block,
+                              this->getBlockPuzzleCount(block),
+                              &puzzles[block * this->header->block_size]);
+        }
+    });
+}
+
+bool Archive::write(const char *path,
+                    const std::vector<PackedBoard> &puzzles,
+                    uint32_t block_size) {
+    if (block_size == 0) {
+        std::cerr << "Failed to write archive '" << path << "': empty blocks" << std::endl;
+        return false;
+    }
+
+    // The first pass checks the clues and counts the row patterns and the ranks. Every rank
+    // starts at 1, so rank models the archive never uses still cover all of their slots.
+    std::array<std::array<uint64_t, 512>, 2> counts    = {};
+    std::array<std::array<uint64_t, 9>, 10> rank_counts = {};
+    for (unsigned int count = FIRST_RANK_MODEL; count <= 9; count++) {
+        std::fill_n(rank_counts[count].begin(), count, 1);
+    }
+
+    Cells cells;
+    for (size_t i = 0; i < puzzles.size(); i++) {
+        unpackCells(puzzles[i], cells);
+        const bool valid = walkPuzzle(
+            cells,
+            [&](unsigned int model, unsigned int value) { counts[model][value]++; },
+            [&](unsigned int rank, unsigned int count) { rank_counts[count][rank]++; });
+        if (!valid) {
+            std::cerr << "Failed to write archive '" << path << "': puzzle " << i + 1
+                      << " has conflicting clues" << std::endl;
+            return false;
+        }
+    }
+
+    std::array<RowModel, 2> rows;
+    for (unsigned int model = 0; model < 2; model++) {
+        normalizeFrequencies(counts[model], rows[model].freqs);
+        buildRowModel(rows[model]);
+    }
+
+    std::array<RankModel, 10> ranks;
+    for (unsigned int count = FIRST_RANK_MODEL; count <= 9; count++) {
+        normalizeFrequencies(rank_counts[count], ranks[count].freqs);
+        buildRankModel(ranks[count], count);
+    }
+
+    ArchiveHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version       = VERSION;
+    header.block_size    = block_size;
+    header.count         = puzzles.size();
+    header.block_count   = (puzzles.size() + block_size - 1) / block_size;
+    header.tables_offset = sizeof(ArchiveHeader);
+
+    const uint64_t blocks_offset = header.tables_offset + TABLES_SIZE;
+    std::vector<uint8_t> data;
+    std::vector<uint64_t> index;
+    RansEncoder encoder;
+    std::vector<std::array<uint16_t, 2>> symbols;
+    for (size_t first = 0; first < puzzles.size(); first += block_size) {
+        index.push_back(blocks_offset + data.size());
+
+        // rANS decodes in reverse, so the symbols of the block are collected first
+        symbols.clear();
+        const size_t last = std::min<size_t>(first + block_size, puzzles.size());
+        for (size_t i = first; i < last; i++) {
+            unpackCells(puzzles[i], cells);
+            walkPuzzle(
+                cells,
+                [&](unsigned int model, unsigned int value) {
+                    symbols.push_back({rows[model].starts[value], rows[model].freqs[value]});
+                },
+                [&](unsigned int rank, unsigned int count) {
+                    symbols.push_back({ranks[count].starts[rank], ranks[count].freqs[rank]});
+                });
+        }
+
+        for (auto symbol = symbols.rbegin(); symbol != symbols.rend(); symbol++) {
+            encoder.put((*symbol)[0], (*symbol)[1]);
+        }
+        encoder.flush(data);
+    }
+    index.push_back(blocks_offset + data.size());
+
+    // The index is aligned so it can be read in place from the mapping
+    static constexpr char padding[8] = {};
+    const size_t padding_size        = (8 - data.size() % 8) % 8;
+    header.index_offset              = blocks_offset + data.size() + padding_size;
+
+    std::ofstream output(path, std::ios::binary);
+    output.write((const char *)&header, sizeof(header));
+    for (const RowModel &model : rows) {
+        output.write((const char *)model.freqs.data(), sizeof(model.freqs));
+    }
+    for (unsigned int count = FIRST_RANK_MODEL; count <= 9; count++) {
+        output.write((const char *)ranks[count].freqs.data(), sizeof(RankModel::freqs));
+    }
+    output.write((const char *)data.data(), data.size());
+    output.write(padding, padding_size);
+    output.write((const char *)index.data(), index.size() * sizeof(uint64_t));
+
+    if (!output) {
+        std::cerr << "Failed to write archive '" << path << "'" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+size_t Archive::getBlockPuzzleCount(size_t block) const {
+    const size_t first = block * this->header->block_size;
+    return std::min<size_t>(this->header->block_size, this->header->count - first);
+}
+
+void Archive::decodeBlock(size_t block, size_t count, PackedBoard *puzzles) const {
+    const uint8_t *data = (const uint8_t *)this->file.getData() + this->index[block];
+
+    RansDecoder decoder(data, this->index[block + 1] - this->index[block]);
+    Cells cells;
+    for (size_t i = 0; i < count; i++) {
+        // Corrupt data can run out of allowed digits, such puzzles come back empty
+        if (!this->decodePuzzle(decoder, cells)) { cells = {}; }
+        packCells(cells, puzzles[i]);
+    }
+}
+
+// Mirror of `walkPuzzle`
+bool Archive::decodePuzzle(RansDecoder &decoder, Cells &cells) const {
+    std::array<uint16_t, 9> patterns = {};
+    std::array<uint16_t, 3 * 9> used = {};
+    cells                            = {};
+    for (unsigned int row = 0; row < 9; row++) {
+        const RowModel &model = this->rows[patternModel(row)];
+        const uint16_t value  = model.patterns[decoder.peek()];
+        decoder.advance(model.starts[value], model.freqs[value]);
+        patterns[row] = row < 5 ? value : value ^ MIRRORED_PATTERNS[patterns[8 - row]];
+
+        for (unsigned int pattern = patterns[row]; pattern != 0; pattern &= pattern - 1) {
+            const unsigned int cell   = row * 9 + std::countr_zero(pattern);
+            const auto &units         = CELL_UNITS[cell];
+            const uint16_t candidates = ~(used[units[0]] | used[units[1]] | used[units[2]]) & 0x1FF;
+            if (candidates == 0) { return false; }
+
+            const unsigned int count = std::popcount(candidates);
+            unsigned int rank        = 0;
+            if (count > 1) {
+                const RankModel &ranks = this->ranks[count];
+                const uint32_t slot    = decoder.peek();
+                rank                   = ranks.ranks[slot >> RankModel::LOOKUP_SHIFT];
+                while (slot >= ranks.starts[rank + 1]) { rank++; }
+                decoder.advance(ranks.starts[rank], ranks.freqs[rank]);
+            }
+
+            const unsigned int digit = SELECT_BIT[candidates][rank];
+            cells[cell]              = digit + 1;
+            used[units[0]] |= 1 << digit;
+            used[units[1]] |= 1 << digit;
+            used[units[2]] |= 1 << digit;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,95 @@
+#ifndef ARCHIVE_HPP
+#define ARCHIVE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "mapped_file.hpp"
+#include "packed_board.hpp"
+#include "rans.hpp"
+#include "thread_pool.hpp"
+
+// Compressed puzzle archive. Every puzzle is coded row by row: the 9-bit clue pattern of the
+// row, then every clue as its rank among the digits the earlier clues still allow. Patterns of
+// the lower rows are coded relative to the mirrored upper rows, so symmetric puzzles cost little
+// more than half a mask. Pattern frequencies and rank frequencies for every number of allowed
+// digits are counted over the whole archive and stored once, the puzzles are split into
+// independent blocks for random access and parallel decoding.
+//
+// The file is an `ArchiveHeader`, the two pattern frequency tables, the rank frequency tables for
+// 2 to 9 allowed digits, the blocks and an index with the offset of every block plus the end of
+// the last one. Numbers are little-endian.
+struct ArchiveHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t block_size;
+    uint64_t count;
+    uint64_t block_count;
+    uint64_t tables_offset;
+    uint64_t index_offset;
+};
+
+static_assert(sizeof(ArchiveHeader) == 48);
+
+// Frequencies of the 512 clue patterns of a row and the pattern of every rANS slot
+struct RowModel {
+    std::array<uint16_t, 512> freqs;
+    std::array<uint16_t, 512> starts;
+    std::array<uint16_t, RANS_TOTAL> patterns;
+};
+
+// Frequencies of the ranks of a clue with a given number of allowed digits. `ranks` holds the
+// rank at the start of every 16 rANS slots, the decoder steps up from there, so all the models
+// together stay small enough for L1 next to the pattern tables.
+struct RankModel {
+    static constexpr unsigned int LOOKUP_SHIFT = 4;
+
+    std::array<uint16_t, 9> freqs;
+    std::array<uint16_t, 10> starts;
+    std::array<uint8_t, (RANS_TOTAL >> LOOKUP_SHIFT)> ranks;
+};
+
+class Archive {
+public:
+    static constexpr char MAGIC[8]               = {'S', 'U', 'D', 'O', 'K', 'U', 'Z', '\0'};
+    static constexpr uint32_t VERSION            = 2;
+    static constexpr uint32_t DEFAULT_BLOCK_SIZE = 1024;
+
+    bool open(const char *path);
+    void close();
+
+    size_t getCount() const;
+    size_t getBlockCount() const;
+    // Puzzles per block, only the last block may have fewer
+    size_t getBlockSize() const;
+
+    // Decodes the block holding `index` up to that puzzle. Returns false when the archive is not
+    // open, `index` is out of range or the puzzle is corrupt.
+    bool getPuzzle(size_t index, Cells &cells) const;
+    // Replaces `puzzles` with the puzzles of `block`
+    void decodeBlock(size_t block, std::vector<PackedBoard> &puzzles) const;
+    // Decodes every block in parallel
+    void decodeAll(ThreadPool &pool, std::vector<PackedBoard> &puzzles) const;
+
+    // Clues of the puzzles are their non-zero cells, puzzles with conflicting clues are rejected
+    static bool write(const char *path,
+                      const std::vector<PackedBoard> &puzzles,
+                      uint32_t block_size = DEFAULT_BLOCK_SIZE);
+
+private:
+    MappedFile file;
+    const ArchiveHeader *header = nullptr;
+    const uint64_t *index       = nullptr;
+    // Models of the upper five rows and of the mirrored lower four
+    std::array<RowModel, 2> rows;
+    // Indexed by the number of allowed digits, clues with a single one are not coded
+    std::array<RankModel, 10> ranks;
+
+    size_t getBlockPuzzleCount(size_t block) const;
+    void decodeBlock(size_t block, size_t count, PackedBoard *puzzles) const;
+    bool decodePuzzle(RansDecoder &decoder, Cells &cells) const;
+};
+
+#endif // ARCHIVE_HPP
@@ -0,0 +1,152 @@
+#include "batch_solver.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "output_file.hpp"
+#include "parallel_solver.hpp"
+#include "puzzle_reader.hpp"
+#include "solver.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+BatchSolver::BatchSolver(unsigned int threads): pool(threads) { }
+
+size_t BatchSolver::solve(const std::vector<Cells> &puzzles, std::vector<Cells> &solutions) {
+    solutions.resize(puzzles.size());
+
+    std::atomic<size_t> solved = 0;
+    this->pool.parallelFor(puzzles.size(), CHUNK_SIZE, [&](size_t begin, size_t end) {
+        Solver<3, 3> solver;
+        size_t count = 0;
+
+        for (size_t i = begin; i < end; i++) {
+            if (solver.solve(puzzles[i])) {
+                solutions[i] = solver.getSolution();
+                count++;
+            } else {
+                solutions[i] = {};
+            }
+        }
+
+        solved += count;
+    });
+
+    return solved;
+}
+
+size_t BatchSolver::solve(const std::vector<PackedBoard> &puzzles,
+                          std::vector<PackedBoard> &solutions) {
+    return this->solvePacked(puzzles.data(), puzzles.size(), solutions);
+}
+
+size_t BatchSolver::solve(const std::vector<PackedBoard> &puzzles,
+                          std::vector<PackedBoard> &solutions,
+                          std::vector<uint64_t> &latencies) {
+    latencies.resize(puzzles.size());
+    return this->solvePacked(puzzles.data(), puzzles.size(), solutions, latencies.data());
+}
+
+size_t BatchSolver::solve(const Corpus &corpus, std::vector<PackedBoard> &solutions) {
+    return this->solvePacked(corpus.getPuzzles(), corpus.getCount(), solutions);
+}
+
+size_t BatchSolver::solve(const Corpus &corpus,
+                          std::vector<PackedBoard> &solutions,
+                          std::vector<uint64_t> &latencies) {
+    latencies.resize(corpus.getCount());
+    return this->solvePacked(corpus.getPuzzles(), corpus.getCount(), solutions, latencies.data());
+}
+
+size_t BatchSolver::solvePacked(const PackedBoard *puzzles,
+                                size_t puzzle_count,
+                                std::vector<PackedBoard> &solutions,
+                                uint64_t *latencies) {
+    solutions.resize(puzzle_count);
+    if (puzzle_count < this->pool.getThreadCount()) {
+        return this->solveSplit(puzzles, puzzle_count, solutions, latencies);
+    }
+
+    std::atomic<size_t> solved = 0;
+    this->pool.parallelFor(puzzle_count, CHUNK_SIZE, [&](size_t begin, size_t end) {
+        Solver<3, 3> solver;
+        size_t count = 0;
+
+        Cells puzzle;
+        for (size_t i = begin; i < end; i++) {
+            const auto start = latencies ? Clock::now() : Clock::time_point();
+
+            unpackCells(puzzles[i], puzzle);
+            if (solver.solve(puzzle)) {
+                packCells(solver.getSolution(), solutions[i]);
+                count++;
+            } else {
+                solutions[i] = {};
+            }
+
+            if (latencies) {
+                latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   Clock::now() - start)
+                                   .count();
+            }
+        }
+
+        solved += count;
+    });
+
+    return solved;
+}
+
+size_t BatchSolver::solveSplit(const PackedBoard *puzzles,
+                               size_t puzzle_count,
+                               std::vector<PackedBoard> &solutions,
+                               uint64_t *latencies) {
+    ParallelSolver solver(this->pool);
+    size_t solved = 0;
+
+    Cells puzzle;
+    for (size_t i = 0; i < puzzle_count; i++) {
+        const auto start = latencies ? Clock::now() : Clock::time_point();
+
+        unpackCells(puzzles[i], puzzle);
+        if (solver.solve(puzzle)) {
+            packCells(solver.getSolution(), solutions[i]);
+            solved++;
+        } else {
+            solutions[i] = {};
+        }
+
+        if (latencies) {
+            latencies[i] =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        }
+    }
+
+    return solved;
+}
+
+bool BatchSolver::solveFile(const char *input_path, const char *output_path) {
+    PuzzleReader reader;
+    if (!reader.open(input_path)) { return false; }
+
+    std::vector<PackedBoard> puzzles;
+    Cells cells;
+    ReadStatus status;
+    while ((status = reader.next(cells)) != READ_END) {
+        // Keep a slot for invalid lines so the output stays aligned, digits above 9 never solve
+        if (status == READ_INVALID) { cells.fill(0xFF); }
+        packCells(cells, puzzles.emplace_back());
+    }
+
+    std::vector<PackedBoard> solutions;
+    this->solve(puzzles, solutions);
+
+    std::string buffer;
+    buffer.reserve(solutions.size() * (9 * 9 + 1));
+    for (const PackedBoard &packed : solutions) { appendCells(packed, buffer); }
+    return writeOutput(output_path, buffer, "solutions");
+}
+
+ThreadPool &BatchSolver::getPool() { return this->pool; }
@@ -0,0 +1,55 @@
+#ifndef BATCH_SOLVER_HPP
+#define BATCH_SOLVER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "board.hpp"
+#include "corpus.hpp"
+#include "packed_board.hpp"
+#include "thread_pool.hpp"
+
+// Solves many independent puzzles on a work-stealing thread pool. Results keep the order of
+// the input, puzzles without a solution come back as an all-zero board. Batches with fewer
+// puzzles than threads, e.g. a single pathological puzzle, are solved one at a time with
+// `ParallelSolver` splitting each search across the pool.
+class BatchSolver {
+public:
+    explicit BatchSolver(unsigned int threads = 0);
+
+    size_t solve(const std::vector<Cells> &puzzles, std::vector<Cells> &solutions);
+    // Same as above on packed boards, which keeps large batches in cache
+    size_t solve(const std::vector<PackedBoard> &puzzles, std::vector<PackedBoard> &solutions);
+    // Also records how long each puzzle took in nanoseconds
+    size_t solve(const std::vector<PackedBoard> &puzzles,
+                 std::vector<PackedBoard> &solutions,
+                 std::vector<uint64_t> &latencies);
+    // Solves the puzzles right out of the mapped corpus
+    size_t solve(const Corpus &corpus, std::vector<PackedBoard> &solutions);
+    size_t solve(const Corpus &corpus,
+                 std::vector<PackedBoard> &solutions,
+                 std::vector<uint64_t> &latencies);
+
+    // Reads one 81 character puzzle per line (`0` or `.` for empty cells) and writes one
+    // solution per line in the same order, see `PuzzleReader`.
+    bool solveFile(const char *input_path, const char *output_path);
+
+    ThreadPool &getPool();
+
+private:
+    static constexpr size_t CHUNK_SIZE = 256;
+
+    ThreadPool pool;
+
+    size_t solvePacked(const PackedBoard *puzzles,
+                       size_t puzzle_count,
+                       std::vector<PackedBoard> &solutions,
+                       uint64_t *latencies = nullptr);
+    size_t solveSplit(const PackedBoard *puzzles,
+                      size_t puzzle_count,
+                      std::vector<PackedBoard> &solutions,
+                      uint64_t *latencies);
+};
+
+#endif // BATCH_SOLVER_HPP
@@ -0,0 +1,9 @@
+#include "board.hpp"
+
+// The sizes used by the app and the tools are compiled once here
+template class Board<2, 2>;
+template class Board<2, 3>;
+template class Board<3, 3>;
+template class Board<3, 4>;
+template class Board<4, 4>;
+template class Board<5, 5>;
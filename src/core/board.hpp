@@ -0,0 +1,254 @@
+#ifndef BOARD_HPP
+#define BOARD_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "geometry.hpp"
+#include "tables.hpp"
+
+enum NumberType {
+    NUMBER_FIXED,
+    NUMBER_CHANGABLE,
+    NUMBER_NOTE, // TODO: implement
+};
+
+struct Number {
+    NumberType type;
+    unsigned int number;
+};
+
+enum ErrorType {
+    ERROR_ROW,
+    ERROR_COLUMN,
+    ERROR_BOX,
+};
+
+struct Error {
+    ErrorType type;
+    unsigned int index;
+    unsigned int number;
+
+    bool operator==(const Error &e) const {
+        return type == e.type && index == e.index && number == e.number;
+    }
+
+    bool operator!=(const Error &e) const { return !(*this == e); }
+};
+
+// Board state and validation without any rendering dependency, so it can be used by headless
+// tools as well as by `Game`.
+//
+// Conflicts are tracked incrementally: every unit counts how many times each digit appears in
+// it, so changing a cell only touches its three units. Every digit that appears more than once
+// in a unit is one `Error`, so a unit can report several duplicate digits at the same time.
+// Every cell also counts the peers holding the same digit, which gives the set of conflicting
+// cells without scanning the board.
+template <unsigned int BoxRows, unsigned int BoxCols>
+class Board {
+public:
+    using Geometry = BoardGeometry<BoxRows, BoxCols>;
+    using Tables   = BoardTables<BoxRows, BoxCols>;
+    using Cells    = typename Geometry::Cells;
+    using Mask     = typename Geometry::Mask;
+    using CellMask = typename Tables::Set;
+
+    Board();
+
+    void clear();
+    // Replaces the board with `puzzle`, its non-zero cells become fixed numbers
+    void load(const Cells &puzzle);
+    const Number &get(unsigned int index) const;
+    bool set(unsigned int index, unsigned int number);
+    Cells getCells() const;
+
+    size_t getErrorCount() const;
+    const Error &getError(size_t index) const;
+    // Digits appearing more than once in `unit`
+    Mask getConflicts(unsigned int unit) const;
+    // Cells sharing their digit with at least one peer
+    const CellMask &getConflictCells() const;
+    // Peers of `index` holding the same digit as it
+    CellMask getClashes(unsigned int index) const;
+
+private:
+    static constexpr unsigned int SIZE       = Geometry::SIZE;
+    static constexpr unsigned int CELL_COUNT = Geometry::CELL_COUNT;
+    static constexpr unsigned int UNIT_COUNT = Geometry::UNIT_COUNT;
+    // A unit can hold at most SIZE / 2 duplicated digits
+    static constexpr size_t MAX_ERRORS = UNIT_COUNT * (SIZE / 2);
+
+    std::array<Number, CELL_COUNT> numbers = {};
+    // Occurrences of digit `n` in every unit, at index `n - 1`
+    std::array<std::array<uint8_t, SIZE>, UNIT_COUNT> digit_counts = {};
+    std::array<Mask, UNIT_COUNT> conflicts                         = {};
+    // Position in `errors` of the error of every unit and digit, valid while it is a conflict
+    std::array<std::array<uint16_t, SIZE>, UNIT_COUNT> error_slots = {};
+    size_t error_count                                             = 0;
+    std::array<Error, MAX_ERRORS> errors                           = {};
+
+    // Cells holding digit `n`, at index `n - 1`
+    std::array<CellMask, SIZE> digit_cells         = {};
+    // Number of peers holding the same digit as every cell
+    std::array<uint8_t, CELL_COUNT> peer_conflicts = {};
+    CellMask conflict_cells                        = {};
+
+    void addNumber(unsigned int index, unsigned int number);
+    void removeNumber(unsigned int index, unsigned int number);
+    void addError(unsigned int unit, unsigned int number);
+    void removeError(unsigned int unit, unsigned int number);
+};
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+Board<BoxRows, BoxCols>::Board() {
+    this->clear();
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+void Board<BoxRows, BoxCols>::clear() {
+    for (size_t i = 0; i < this->numbers.size(); i++) {
+        this->numbers[i].type   = NUMBER_CHANGABLE;
+        this->numbers[i].number = 0;
+    }
+
+    this->digit_counts   = {};
+    this->conflicts      = {};
+    this->error_count    = 0;
+    this->digit_cells    = {};
+    this->peer_conflicts = {};
+    this->conflict_cells = {};
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+void Board<BoxRows, BoxCols>::load(const Cells &puzzle) {
+    this->clear();
+    for (size_t i = 0; i < this->numbers.size(); i++) {
+        if (puzzle[i] == 0) { continue; }
+
+        this->numbers[i].type   = NUMBER_FIXED;
+        this->numbers[i].number = puzzle[i];
+        this->addNumber(i, puzzle[i]);
+    }
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+const Number &Board<BoxRows, BoxCols>::get(unsigned int index) const {
+    return this->numbers[index];
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+bool Board<BoxRows, BoxCols>::set(unsigned int index, unsigned int number) {
+    Number &cell = this->numbers[index];
+    if (cell.type == NUMBER_FIXED) { return false; }
+    if (cell.number == number) { return true; }
+
+    if (cell.number != 0) { this->removeNumber(index, cell.number); }
+    cell.number = number;
+    if (number != 0) { this->addNumber(index, number); }
+
+    return true;
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+typename Board<BoxRows, BoxCols>::Cells Board<BoxRows, BoxCols>::getCells() const {
+    Cells cells;
+    for (size_t i = 0; i < cells.size(); i++) { cells[i] = this->numbers[i].number; }
+
+    return cells;
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+size_t Board<BoxRows, BoxCols>::getErrorCount() const {
+    return this->error_count;
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+const Error &Board<BoxRows, BoxCols>::getError(size_t index) const {
+    return this->errors[index];
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+typename Board<BoxRows, BoxCols>::Mask
+Board<BoxRows, BoxCols>::getConflicts(unsigned int unit) const {
+    return this->conflicts[unit];
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+const typename Board<BoxRows, BoxCols>::CellMask &
+Board<BoxRows, BoxCols>::getConflictCells() const {
+    return this->conflict_cells;
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+typename Board<BoxRows, BoxCols>::CellMask
+Board<BoxRows, BoxCols>::getClashes(unsigned int index) const {
+    const unsigned int number = this->numbers[index].number;
+    if (number == 0) { return {}; }
+
+    return Tables::PEER_MASKS[index] & this->digit_cells[number - 1];
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+void Board<BoxRows, BoxCols>::addNumber(unsigned int index, unsigned int number) {
+    for (unsigned int unit : Tables::CELL_UNITS[index]) {
+        if (++this->digit_counts[unit][number - 1] == 2) { this->addError(unit, number); }
+    }
+
+    const CellMask clashes = Tables::PEER_MASKS[index] & this->digit_cells[number - 1];
+    for (unsigned int peer = clashes.next(0); peer < CELL_COUNT; peer = clashes.next(peer + 1)) {
+        if (this->peer_conflicts[peer]++ == 0) { this->conflict_cells.set(peer); }
+    }
+
+    this->peer_conflicts[index] = clashes.count();
+    if (this->peer_conflicts[index] != 0) { this->conflict_cells.set(index); }
+    this->digit_cells[number - 1].set(index);
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+void Board<BoxRows, BoxCols>::removeNumber(unsigned int index, unsigned int number) {
+    for (unsigned int unit : Tables::CELL_UNITS[index]) {
+        if (this->digit_counts[unit][number - 1]-- == 2) { this->removeError(unit, number); }
+    }
+
+    this->digit_cells[number - 1].reset(index);
+    const CellMask clashes = Tables::PEER_MASKS[index] & this->digit_cells[number - 1];
+    for (unsigned int peer = clashes.next(0); peer < CELL_COUNT; peer = clashes.next(peer + 1)) {
+        if (--this->peer_conflicts[peer] == 0) { this->conflict_cells.reset(peer); }
+    }
+
+    this->peer_conflicts[index] = 0;
+    this->conflict_cells.reset(index);
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+void Board<BoxRows, BoxCols>::addError(unsigned int unit, unsigned int number) {
+    // Units are numbered rows first, then columns and boxes, same as `ErrorType`
+    const unsigned int type = unit < SIZE ? ERROR_ROW : unit < 2 * SIZE ? ERROR_COLUMN : ERROR_BOX;
+
+    this->conflicts[unit] |= Mask(1) << (number - 1);
+    this->error_slots[unit][number - 1] = this->error_count;
+    this->errors[this->error_count++]   = {ErrorType(type), unit - type * SIZE, number};
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+void Board<BoxRows, BoxCols>::removeError(unsigned int unit, unsigned int number) {
+    this->conflicts[unit] &= ~(Mask(1) << (number - 1));
+
+    // Move the last error into the freed slot
+    const size_t slot            = this->error_slots[unit][number - 1];
+    const Error &last            = this->errors[--this->error_count];
+    const unsigned int last_unit = last.type * SIZE + last.index;
+
+    this->error_slots[last_unit][last.number - 1] = slot;
+    this->errors[slot]                            = last;
+}
+
+extern template class Board<2, 2>;
+extern template class Board<2, 3>;
+extern template class Board<3, 3>;
+extern template class Board<3, 4>;
+extern template class Board<4, 4>;
+extern template class Board<5, 5>;
+
+#endif // BOARD_HPP
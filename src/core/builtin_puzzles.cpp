@@ -0,0 +1,77 @@
+#include "builtin_puzzles.hpp"
+
+#include <array>
+#include <utility>
+
+#include "solver.hpp"
+
+// One 81 character puzzle per entry, `0` for empty cells, roughly from easy to hard
+static constexpr std::array<const char *, 12> PUZZLE_SOURCES = {
+    "530070000600195000098000060800060003400803001700020006060000280000419005000080079",
+    "020810740700003100090002805009040087400208003160030200302700060005600008076051090",
+    "480006902002008001900370060840010200003704100001060049020085007700900600609200018",
+    "003020600900305001001806400008102900700000008006708200002609500800203009005010300",
+    "200080300060070084030500209000105408000000000402706000301007040720040060004010003",
+    "030050040008010500460000012070502080000603000040109030250000098001020600080060020",
+    "000000907000420180000705026100904000050000040000507009920108000034059000507000000",
+    "000900002050123400030000160908000000070000090000000205091000050007439020400007000",
+    "043080250600000000000001094900004070000608000010200003820500000000000005034090710",
+    "001900003900700160030005007050000009004302600200000070600100030042007006500006800",
+    "100920000524010000000000070050008102000000000402700090060000000000030945000071006",
+    "000000010400000000020000000000050407008000300001090000300400200050100000000806000",
+};
+
+struct CheckedPuzzle {
+    bool well_formed            = true;
+    unsigned int solution_count = 0;
+    BuiltinPuzzle puzzle        = {};
+};
+
+static constexpr CheckedPuzzle checkPuzzle(const char *source) {
+    CheckedPuzzle result;
+    for (unsigned int i = 0; i < result.puzzle.puzzle.size(); i++) {
+        if (source[i] < '0' || source[i] > '9') {
+            result.well_formed = false;
+            return result;
+        }
+
+        result.puzzle.puzzle[i] = source[i] - '0';
+    }
+    if (source[result.puzzle.puzzle.size()] != '\0') { result.well_formed = false; }
+
+    Solver<3, 3> solver;
+    result.solution_count  = solver.countSolutions(result.puzzle.puzzle, 2);
+    result.puzzle.solution = solver.getSolution();
+    return result;
+}
+
+// A variable template gets its own constant evaluation, so every puzzle has the full budget of
+// compile time steps instead of sharing it with the rest of the table
+template <size_t Index>
+static constexpr CheckedPuzzle CHECKED_PUZZLE = checkPuzzle(PUZZLE_SOURCES[Index]);
+
+template <size_t... Indices>
+static constexpr bool allUnique(std::index_sequence<Indices...>) {
+    return ((CHECKED_PUZZLE<Indices>.well_formed && CHECKED_PUZZLE<Indices>.solution_count == 1)
+            && ...);
+}
+
+template <size_t... Indices>
+static constexpr std::array<BuiltinPuzzle, sizeof...(Indices)>
+makeTable(std::index_sequence<Indices...>) {
+    return {CHECKED_PUZZLE<Indices>.puzzle...};
+}
+
+static_assert(allUnique(std::make_index_sequence<PUZZLE_SOURCES.size()>()),
+              "Every built-in puzzle must have exactly one solution");
+
+static constexpr std::array<BuiltinPuzzle, PUZZLE_SOURCES.size()> BUILTIN_PUZZLES =
+    makeTable(std::make_index_sequence<PUZZLE_SOURCES.size()>());
+
+size_t getBuiltinPuzzleCount() {
+    return BUILTIN_PUZZLES.size();
+}
+
+const BuiltinPuzzle &getBuiltinPuzzle(size_t index) {
+    return BUILTIN_PUZZLES[index];
+}
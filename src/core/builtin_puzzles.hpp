@@ -0,0 +1,18 @@
+#ifndef BUILTIN_PUZZLES_HPP
+#define BUILTIN_PUZZLES_HPP
+
+#include <cstddef>
+
+#include "geometry.hpp"
+
+struct BuiltinPuzzle {
+    Cells puzzle;
+    Cells solution;
+};
+
+// Puzzles compiled into the binary. Every one of them is checked to have exactly one solution
+// at compile time and the solutions are stored next to them.
+size_t getBuiltinPuzzleCount();
+const BuiltinPuzzle &getBuiltinPuzzle(size_t index);
+
+#endif // BUILTIN_PUZZLES_HPP
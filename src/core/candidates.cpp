@@ -0,0 +1,171 @@
+#include "candidates.hpp"
+
+#include <cstring>
+
+#include <immintrin.h>
+
+#include "cpu_features.hpp"
+#include "kernels.hpp"
+#include "tables.hpp"
+
+static constexpr uint16_t ALL_DIGITS = 0x1FF;
+
+void computeCandidates(const Cells &cells, Candidates &candidates) {
+    Kernels::get().computeCandidates(cells, candidates);
+}
+
+void computeCandidatesScalar(const Cells &cells, Candidates &candidates) {
+    std::array<uint16_t, 3 * 9> used = {};
+    for (unsigned int i = 0; i < 9 * 9; i++) {
+        if (cells[i] == 0 || cells[i] > 9) { continue; }
+
+        const uint16_t bit = 1 << (cells[i] - 1);
+        for (unsigned int unit : CELL_UNITS[i]) { used[unit] |= bit; }
+    }
+
+    for (unsigned int i = 0; i < 9 * 9; i++) {
+        const auto &units = CELL_UNITS[i];
+        const uint16_t all = used[units[0]] | used[units[1]] | used[units[2]];
+        candidates[i]      = cells[i] == 0 || cells[i] > 9 ? ~all & ALL_DIGITS : 0;
+    }
+}
+
+// Every row is copied into its own 16 byte line so that the digits of a column share a lane.
+static inline void loadRows(const Cells &cells, uint8_t (&rows)[9][16]) {
+    std::memset(rows, 0, sizeof(rows));
+    for (unsigned int r = 0; r < 9; r++) { std::memcpy(rows[r], &cells[r * 9], 9); }
+}
+
+// Digit to bit lookup split into the low and the high byte of the 16-bit mask
+static inline __m128i lowBitTable() {
+    return _mm_setr_epi8(0, 1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0);
+}
+
+static inline __m128i highBitTable() {
+    return _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+}
+
+TARGET_SSE42 void computeCandidatesSse42(const Cells &cells, Candidates &candidates) {
+    alignas(16) uint8_t rows[9][16];
+    loadRows(cells, rows);
+
+    const __m128i low_table  = lowBitTable();
+    const __m128i high_table = highBitTable();
+    const __m128i ten        = _mm_set1_epi8(10);
+
+    // Lanes 0-7 of a row live in `low` and lane 8 in the first lane of `high`
+    __m128i low[9], high[9];
+    __m128i columns_low = _mm_setzero_si128(), columns_high = _mm_setzero_si128();
+    for (unsigned int r = 0; r < 9; r++) {
+        const __m128i digits = _mm_min_epu8(_mm_load_si128((const __m128i *)rows[r]), ten);
+        const __m128i lo     = _mm_shuffle_epi8(low_table, digits);
+        const __m128i hi     = _mm_shuffle_epi8(high_table, digits);
+
+        low[r]       = _mm_unpacklo_epi8(lo, hi);
+        high[r]      = _mm_unpackhi_epi8(lo, hi);
+        columns_low  = _mm_or_si128(columns_low, low[r]);
+        columns_high = _mm_or_si128(columns_high, high[r]);
+    }
+
+    const __m128i all_digits      = _mm_set1_epi16(ALL_DIGITS);
+    const __m128i zero            = _mm_setzero_si128();
+    const __m128i box_spread_low  =
+        _mm_setr_epi8(0, 1, 0, 1, 0, 1, 6, 7, 6, 7, 6, 7, 12, 13, 12, 13);
+    const __m128i box_spread_high =
+        _mm_setr_epi8(12, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    for (unsigned int band = 0; band < 3; band++) {
+        const __m128i band_low  = _mm_or_si128(_mm_or_si128(low[band * 3], low[band * 3 + 1]),
+                                              low[band * 3 + 2]);
+        const __m128i band_high = _mm_or_si128(_mm_or_si128(high[band * 3], high[band * 3 + 1]),
+                                               high[band * 3 + 2]);
+
+        // Lanes 0, 3 and 6 of `triples` hold the masks of the three boxes of the band
+        const __m128i shift_one  = _mm_alignr_epi8(band_high, band_low, 2);
+        const __m128i shift_two  = _mm_alignr_epi8(band_high, band_low, 4);
+        const __m128i triples    = _mm_or_si128(_mm_or_si128(band_low, shift_one), shift_two);
+        const __m128i boxes_low  = _mm_shuffle_epi8(triples, box_spread_low);
+        const __m128i boxes_high = _mm_shuffle_epi8(triples, box_spread_high);
+
+        for (unsigned int r = band * 3; r < band * 3 + 3; r++) {
+            __m128i row = _mm_or_si128(low[r], high[r]);
+            row         = _mm_or_si128(row, _mm_srli_si128(row, 8));
+            row         = _mm_or_si128(row, _mm_srli_si128(row, 4));
+            row         = _mm_or_si128(row, _mm_srli_si128(row, 2));
+            row         = _mm_shufflelo_epi16(row, 0);
+            row         = _mm_unpacklo_epi64(row, row);
+
+            const __m128i used_low  = _mm_or_si128(_mm_or_si128(row, columns_low), boxes_low);
+            const __m128i used_high = _mm_or_si128(_mm_or_si128(row, columns_high), boxes_high);
+            const __m128i cand_low  = _mm_and_si128(_mm_andnot_si128(used_low, all_digits),
+                                                   _mm_cmpeq_epi16(low[r], zero));
+            const __m128i cand_high = _mm_and_si128(_mm_andnot_si128(used_high, all_digits),
+                                                    _mm_cmpeq_epi16(high[r], zero));
+
+            _mm_storeu_si128((__m128i *)&candidates[r * 9], cand_low);
+            candidates[r * 9 + 8] = _mm_cvtsi128_si32(cand_high);
+        }
+    }
+}
+
+TARGET_AVX2 void computeCandidatesAvx2(const Cells &cells, Candidates &candidates) {
+    alignas(16) uint8_t rows[9][16];
+    loadRows(cells, rows);
+
+    const __m128i low_table  = lowBitTable();
+    const __m128i high_table = highBitTable();
+    const __m128i ten        = _mm_set1_epi8(10);
+
+    // One row per register, 16-bit lane per column
+    __m256i bits[9];
+    __m256i columns = _mm256_setzero_si256();
+    for (unsigned int r = 0; r < 9; r++) {
+        const __m128i digits = _mm_min_epu8(_mm_load_si128((const __m128i *)rows[r]), ten);
+        const __m128i lo     = _mm_shuffle_epi8(low_table, digits);
+        const __m128i hi     = _mm_shuffle_epi8(high_table, digits);
+
+        bits[r] = _mm256_set_m128i(_mm_unpackhi_epi8(lo, hi), _mm_unpacklo_epi8(lo, hi));
+        columns = _mm256_or_si256(columns, bits[r]);
+    }
+
+    const __m256i all_digits = _mm256_set1_epi16(ALL_DIGITS);
+    const __m256i zero       = _mm256_setzero_si256();
+    const __m256i box_spread = _mm256_setr_epi8(0, 1, 0, 1, 0, 1, 6, 7, 6, 7, 6, 7, 12, 13, 12, 13,
+                                                12, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                -1, -1, -1, -1);
+    for (unsigned int band = 0; band < 3; band++) {
+        const __m256i band_bits = _mm256_or_si256(
+            _mm256_or_si256(bits[band * 3], bits[band * 3 + 1]), bits[band * 3 + 2]);
+
+        // Shift the whole register down by one and two lanes so that lanes 0, 3 and 6 end up
+        // with the masks of the three boxes of the band
+        const __m256i upper   = _mm256_permute2x128_si256(band_bits, band_bits, 0x81);
+        const __m256i triples = _mm256_or_si256(
+            _mm256_or_si256(band_bits, _mm256_alignr_epi8(upper, band_bits, 2)),
+            _mm256_alignr_epi8(upper, band_bits, 4));
+        const __m256i boxes = _mm256_shuffle_epi8(
+            _mm256_permute2x128_si256(triples, triples, 0x00), box_spread);
+        const __m256i columns_boxes = _mm256_or_si256(columns, boxes);
+
+        for (unsigned int r = band * 3; r < band * 3 + 3; r++) {
+            __m128i row = _mm_or_si128(_mm256_castsi256_si128(bits[r]),
+                                       _mm256_extracti128_si256(bits[r], 1));
+            row         = _mm_or_si128(row, _mm_srli_si128(row, 8));
+            row         = _mm_or_si128(row, _mm_srli_si128(row, 4));
+            row         = _mm_or_si128(row, _mm_srli_si128(row, 2));
+
+            const __m256i used = _mm256_or_si256(_mm256_broadcastw_epi16(row), columns_boxes);
+            const __m256i cand = _mm256_and_si256(_mm256_andnot_si256(used, all_digits),
+                                                  _mm256_cmpeq_epi16(bits[r], zero));
+
+            // Rows are written in order, so the spill of a full store is overwritten by the
+            // next row. The last one would run past the end of the array.
+            if (r < 8) {
+                _mm256_storeu_si256((__m256i *)&candidates[r * 9], cand);
+            } else {
+                alignas(32) uint16_t result[16];
+                _mm256_store_si256((__m256i *)result, cand);
+                std::memcpy(&candidates[r * 9], result, 9 * sizeof(uint16_t));
+            }
+        }
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef CANDIDATES_HPP
+#define CANDIDATES_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "board.hpp"
+
+// 9-bit candidate mask of every cell, bit `n - 1` set when `n` can be placed. Filled cells
+// have no candidates.
+using Candidates = std::array<uint16_t, 9 * 9>;
+
+// Computes the candidates of all cells at once with the kernel selected by `Kernels`. Values
+// above 9 are not digits, every kernel treats them as empty cells.
+void computeCandidates(const Cells &cells, Candidates &candidates);
+
+void computeCandidatesScalar(const Cells &cells, Candidates &candidates);
+void computeCandidatesSse42(const Cells &cells, Candidates &candidates);
+void computeCandidatesAvx2(const Cells &cells, Candidates &candidates);
+
+#endif // CANDIDATES_HPP
@@ -0,0 +1,74 @@
+#ifndef CELL_SET_HPP
+#define CELL_SET_HPP
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+// Fixed-size set of cell indices, one bit per cell, usable in constant expressions. 81 cells
+// fit in two words.
+template <unsigned int Count>
+class CellSet {
+public:
+    static constexpr unsigned int WORD_COUNT = (Count + 63) / 64;
+
+    constexpr bool test(unsigned int cell) const {
+        return (this->words[cell / 64] >> (cell % 64)) & 1;
+    }
+
+    constexpr void set(unsigned int cell) { this->words[cell / 64] |= uint64_t(1) << (cell % 64); }
+
+    constexpr void reset(unsigned int cell) {
+        this->words[cell / 64] &= ~(uint64_t(1) << (cell % 64));
+    }
+
+    constexpr bool any() const {
+        for (uint64_t word : this->words) {
+            if (word) { return true; }
+        }
+        return false;
+    }
+
+    constexpr unsigned int count() const {
+        unsigned int result = 0;
+        for (uint64_t word : this->words) { result += std::popcount(word); }
+        return result;
+    }
+
+    // First cell in the set at or after `from`, `Count` if there is none
+    constexpr unsigned int next(unsigned int from) const {
+        for (unsigned int w = from / 64; w < WORD_COUNT; w++) {
+            uint64_t word = this->words[w];
+            if (w == from / 64) { word &= ~uint64_t(0) << (from % 64); }
+            if (word) { return w * 64 + std::countr_zero(word); }
+        }
+        return Count;
+    }
+
+    constexpr CellSet &operator&=(const CellSet &other) {
+        for (unsigned int w = 0; w < WORD_COUNT; w++) { this->words[w] &= other.words[w]; }
+        return *this;
+    }
+
+    constexpr CellSet &operator|=(const CellSet &other) {
+        for (unsigned int w = 0; w < WORD_COUNT; w++) { this->words[w] |= other.words[w]; }
+        return *this;
+    }
+
+    constexpr CellSet &operator^=(const CellSet &other) {
+        for (unsigned int w = 0; w < WORD_COUNT; w++) { this->words[w] ^= other.words[w]; }
+        return *this;
+    }
+
+    constexpr CellSet operator&(const CellSet &other) const { return CellSet(*this) &= other; }
+    constexpr CellSet operator|(const CellSet &other) const { return CellSet(*this) |= other; }
+    constexpr CellSet operator^(const CellSet &other) const { return CellSet(*this) ^= other; }
+    constexpr bool operator==(const CellSet &other) const = default;
+
+    constexpr const std::array<uint64_t, WORD_COUNT> &getWords() const { return this->words; }
+
+private:
+    std::array<uint64_t, WORD_COUNT> words = {};
+};
+
+#endif // CELL_SET_HPP
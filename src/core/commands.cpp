@@ -0,0 +1,419 @@
+#include "commands.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "archive.hpp"
+#include "batch_solver.hpp"
+#include "corpus.hpp"
+#include "difficulty.hpp"
+#include "generator.hpp"
+#include "grid_generator.hpp"
+#include "latency.hpp"
+#include "output_file.hpp"
+#include "packed_board.hpp"
+#include "pattern_generator.hpp"
+#include "puzzle_reader.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct CommandOptions {
+    const char *input_path  = "-";
+    const char *output_path = "-";
+    unsigned int threads    = 0;
+    size_t count            = 1;
+    uint64_t seed           = 0;
+    unsigned int clues      = 0;
+    bool independent        = false;
+    const char *symmetry    = nullptr;
+};
+
+static bool parseOptions(const char *usage,
+                         int arg_count,
+                         char **args,
+                         CommandOptions &options) {
+    for (int i = 0; i < arg_count; i++) {
+        const bool has_value = i + 1 < arg_count;
+        if (std::strcmp(args[i], "-o") == 0 && has_value) {
+            options.output_path = args[++i];
+        } else if (std::strcmp(args[i], "-j") == 0 && has_value) {
+            options.threads = std::strtoul(args[++i], nullptr, 10);
+        } else if (std::strcmp(args[i], "-n") == 0 && has_value) {
+            options.count = std::strtoull(args[++i], nullptr, 10);
+        } else if (std::strcmp(args[i], "--seed") == 0 && has_value) {
+            options.seed = std::strtoull(args[++i], nullptr, 10);
+        } else if (std::strcmp(args[i], "--clues") == 0 && has_value) {
+            options.clues = std::strtoul(args[++i], nullptr, 10);
+        } else if (std::strcmp(args[i], "--symmetry") == 0 && has_value) {
+            options.symmetry = args[++i];
+        } else if (std::strcmp(args[i], "--independent") == 0) {
+            options.independent = true;
+        } else if (args[i][0] != '-' || std::strcmp(args[i], "-") == 0) {
+            options.input_path = args[i];
+        } else {
+            std::cerr << "Usage: Sudoku " << usage << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int runSolveCommand(int arg_count, char **args) {
+    CommandOptions options;
+    if (!parseOptions("--solve [input] [-o output] [-j threads]", arg_count, args, options)) {
+        return -1;
+    }
+
+    // A binary corpus is solved straight out of its mapping, without a parse phase
+    const auto read_start = Clock::now();
+    const bool is_corpus  = std::strcmp(options.input_path, "-") != 0
+                        && Corpus::isCorpus(options.input_path);
+    Corpus corpus;
+    std::vector<PackedBoard> puzzles;
+    if (is_corpus) {
+        if (!corpus.open(options.input_path)) { return -1; }
+    } else {
+        PuzzleReader reader;
+        if (!reader.open(options.input_path)) { return -1; }
+
+        Cells cells;
+        ReadStatus status;
+        while ((status = reader.next(cells)) != READ_END) {
+            // Keep a slot for invalid lines so the output stays aligned, 0xFF digits never solve
+            if (status == READ_INVALID) { cells.fill(0xFF); }
+            packCells(cells, puzzles.emplace_back());
+        }
+    }
+    const size_t puzzle_count = is_corpus ? corpus.getCount() : puzzles.size();
+    const double read_time    = secondsSince(read_start);
+
+    const auto solve_start = Clock::now();
+    BatchSolver solver(options.threads);
+    std::vector<PackedBoard> solutions;
+    std::vector<uint64_t> latencies;
+    const size_t solved     = is_corpus ? solver.solve(corpus, solutions, latencies)
+                                        : solver.solve(puzzles, solutions, latencies);
+    const double solve_time = secondsSince(solve_start);
+
+    const auto write_start = Clock::now();
+
+    std::string buffer;
+    buffer.reserve(solutions.size() * (9 * 9 + 1));
+    for (const PackedBoard &packed : solutions) { appendCells(packed, buffer); }
+    if (!writeOutput(options.output_path, buffer, "solutions")) { return -1; }
+    const double write_time = secondsSince(write_start);
+
+    const double total_time      = read_time + solve_time + write_time;
+    const LatencySummary latency = summarizeLatencies(latencies);
+    std::fprintf(stderr,
+                 "Solved %zu of %zu puzzles in %.3f s (%.0f puzzles/s) on %u threads\n"
+                 "  read %.3f s, solve %.3f s, write %.3f s\n"
+                 "  latency us: mean %.1f, p50 %.1f, p90 %.1f, p99 %.1f, p99.9 %.1f, max %.1f\n",
+                 solved,
+                 puzzle_count,
+                 total_time,
+                 puzzle_count / total_time,
+                 solver.getPool().getThreadCount(),
+                 read_time,
+                 solve_time,
+                 write_time,
+                 latency.mean / 1e3,
+                 latency.p50 / 1e3,
+                 latency.p90 / 1e3,
+                 latency.p99 / 1e3,
+                 latency.p999 / 1e3,
+                 latency.max / 1e3);
+
+    return solved == puzzle_count ? 0 : 1;
+}
+
+int runCorpusCommand(int arg_count, char **args) {
+    CommandOptions options;
+    if (!parseOptions("--corpus [input] -o output [-j threads]", arg_count, args, options)) {
+        return -1;
+    }
+    if (std::strcmp(options.output_path, "-") == 0) {
+        std::cerr << "Failed to write the corpus: it needs an output file" << std::endl;
+        return -1;
+    }
+
+    const auto start = Clock::now();
+    PuzzleReader reader;
+    if (!reader.open(options.input_path)) { return -1; }
+
+    std::vector<PackedBoard> puzzles;
+    std::vector<PuzzleInfo> info;
+    Cells cells;
+    ReadStatus status;
+    while ((status = reader.next(cells)) != READ_END) {
+        if (status != READ_OK) { continue; }
+
+        PuzzleInfo &puzzle_info = info.emplace_back();
+        for (uint8_t digit : cells) { puzzle_info.clue_count += digit != 0; }
+        packCells(cells, puzzles.emplace_back());
+    }
+
+    BatchSolver solver(options.threads);
+    std::vector<PackedBoard> solved;
+    solver.solve(puzzles, solved);
+
+    // Both run on the solver's pool, two full-width pools would oversubscribe the cores
+    DifficultyRater rater(solver.getPool());
+    std::vector<Rating> ratings;
+    rater.rate(puzzles, ratings);
+
+    // Only found solutions are stored, an all-zero board means there was none
+    std::vector<PackedBoard> solutions;
+    for (size_t i = 0; i < puzzles.size(); i++) {
+        info[i].difficulty = ratings[i].score;
+        info[i].solution   = PuzzleInfo::NO_SOLUTION;
+        if (solved[i] == PackedBoard()) { continue; }
+
+        info[i].solution = solutions.size();
+        solutions.push_back(solved[i]);
+    }
+
+    if (!Corpus::write(options.output_path, puzzles, info, solutions)) { return -1; }
+
+    std::fprintf(stderr,
+                 "Wrote %zu puzzles (%zu solved) to a corpus in %.3f s on %u threads\n",
+                 puzzles.size(),
+                 solutions.size(),
+                 secondsSince(start),
+                 solver.getPool().getThreadCount());
+    return 0;
+}
+
+int runArchiveCommand(int arg_count, char **args) {
+    CommandOptions options;
+    if (!parseOptions("--archive [input] -o output", arg_count, args, options)) { return -1; }
+    if (std::strcmp(options.output_path, "-") == 0) {
+        std::cerr << "Failed to write the archive: it needs an output file" << std::endl;
+        return -1;
+    }
+
+    const auto start = Clock::now();
+    PuzzleReader reader;
+    if (!reader.open(options.input_path)) { return -1; }
+
+    std::vector<PackedBoard> puzzles;
+    Cells cells;
+    ReadStatus status;
+    while ((status = reader.next(cells)) != READ_END) {
+        if (status == READ_OK) { packCells(cells, puzzles.emplace_back()); }
+    }
+
+    if (!Archive::write(options.output_path, puzzles)) { return -1; }
+
+    std::error_code error;
+    const uintmax_t size = std::filesystem::file_size(options.output_path, error);
+    std::fprintf(stderr,
+                 "Archived %zu puzzles in %.3f s, %.2f bytes per puzzle\n",
+                 puzzles.size(),
+                 secondsSince(start),
+                 puzzles.empty() || error ? 0.0 : double(size) / puzzles.size());
+    return 0;
+}
+
+int runUnarchiveCommand(int arg_count, char **args) {
+    CommandOptions options;
+    if (!parseOptions("--unarchive input [-o output] [-j threads]", arg_count, args, options)) {
+        return -1;
+    }
+
+    // Archives are mapped, so they cannot come from standard input
+    if (std::strcmp(options.input_path, "-") == 0) {
+        std::cerr << "Failed to read the archive: it needs an input file" << std::endl;
+        return -1;
+    }
+
+    Archive archive;
+    if (!archive.open(options.input_path)) { return -1; }
+
+    const auto start = Clock::now();
+    ThreadPool pool(options.threads);
+    std::vector<PackedBoard> puzzles;
+    archive.decodeAll(pool, puzzles);
+    const double seconds = secondsSince(start);
+
+    std::string buffer;
+    buffer.reserve(puzzles.size() * (9 * 9 + 1));
+    for (const PackedBoard &packed : puzzles) { appendCells(packed, buffer); }
+    if (!writeOutput(options.output_path, buffer, "puzzles")) { return -1; }
+
+    std::fprintf(stderr,
+                 "Decoded %zu puzzles in %.3f s (%.0f puzzles/s) on %u threads\n",
+                 puzzles.size(),
+                 seconds,
+                 puzzles.size() / seconds,
+                 pool.getThreadCount());
+    return 0;
+}
+
+int runRateCommand(int arg_count, char **args) {
+    CommandOptions options;
+    if (!parseOptions("--rate [input] [-o output] [-j threads]", arg_count, args, options)) {
+        return -1;
+    }
+
+    const auto start = Clock::now();
+    DifficultyRater rater(options.threads);
+    if (!rater.rateFile(options.input_path, options.output_path)) { return -1; }
+
+    std::fprintf(stderr,
+                 "Rated in %.3f s on %u threads\n",
+                 secondsSince(start),
+                 rater.getPool().getThreadCount());
+    return 0;
+}
+
+int runGenerateCommand(int arg_count, char **args) {
+    CommandOptions options;
+    const char *usage = "--generate [-n count] [--clues count] [--seed seed] [-o output] "
+                        "[-j threads]";
+    if (!parseOptions(usage, arg_count, args, options)) { return -1; }
+
+    if (options.clues != 0 && options.clues < MIN_TARGET_CLUES) {
+        std::cerr << "Failed to generate puzzles: fewer than " << MIN_TARGET_CLUES
+                  << " clues are not supported" << std::endl;
+        return -1;
+    }
+    if (options.clues > 9 * 9) {
+        std::cerr << "Failed to generate puzzles: a puzzle has at most " << 9 * 9 << " clues"
+                  << std::endl;
+        return -1;
+    }
+
+    const auto start = Clock::now();
+    PuzzleGenerator generator(options.threads);
+    std::vector<PackedBoard> puzzles;
+    const size_t met     = generator.generate(options.count, options.seed, options.clues, puzzles);
+    const double seconds = secondsSince(start);
+
+    std::string buffer;
+    buffer.reserve(puzzles.size() * (9 * 9 + 1));
+    for (const PackedBoard &packed : puzzles) { appendCells(packed, buffer); }
+    if (!writeOutput(options.output_path, buffer, "puzzles")) { return -1; }
+
+    const GeneratorStats &stats = generator.getStats();
+    std::fprintf(stderr,
+                 "Generated %zu puzzles (%zu on target) in %.3f s (%.1f puzzles/s) on %u threads\n"
+                 "  %.2f grids and %.1f uniqueness checks per puzzle\n",
+                 puzzles.size(),
+                 met,
+                 seconds,
+                 puzzles.size() / seconds,
+                 generator.getPool().getThreadCount(),
+                 puzzles.empty() ? 0.0 : double(stats.grids) / puzzles.size(),
+                 puzzles.empty() ? 0.0 : double(stats.checks) / puzzles.size());
+
+    return met == puzzles.size() ? 0 : 1;
+}
+
+int runGridsCommand(int arg_count, char **args) {
+    CommandOptions options;
+    const char *usage = "--grids [-n count] [--independent] [--seed seed] [-o output] [-j threads]";
+    if (!parseOptions(usage, arg_count, args, options)) { return -1; }
+
+    const auto start = Clock::now();
+    ThreadPool pool(options.threads);
+    // Independent grids never touch the pool of seed grids
+    const GridGenerator generator(options.seed,
+                                  options.independent ? 0 : GridGenerator::DEFAULT_SEED_GRIDS);
+    std::vector<PackedBoard> grids(options.count);
+    generator.generate(pool, options.seed, options.independent, grids.data(), grids.size());
+    const double seconds = secondsSince(start);
+
+    std::string buffer;
+    buffer.reserve(grids.size() * (9 * 9 + 1));
+    for (const PackedBoard &packed : grids) { appendCells(packed, buffer); }
+    if (!writeOutput(options.output_path, buffer, "grids")) { return -1; }
+
+    std::fprintf(stderr,
+                 "Generated %zu grids in %.3f s (%.0f grids/s) on %u threads\n",
+                 grids.size(),
+                 seconds,
+                 grids.size() / seconds,
+                 pool.getThreadCount());
+    return 0;
+}
+
+int runPatternCommand(int arg_count, char **args) {
+    CommandOptions options;
+    const char *usage = "--pattern [patterns] [--symmetry name --clues count] [-n count] "
+                        "[--seed seed] [-o output] [-j threads]";
+    if (!parseOptions(usage, arg_count, args, options)) { return -1; }
+
+    std::vector<ClueMask> masks;
+    if (options.symmetry) {
+        const Symmetry symmetry = parseSymmetry(options.symmetry);
+        if (symmetry == SYMMETRY_COUNT) {
+            std::cerr << "Failed to generate puzzles: unknown symmetry '" << options.symmetry
+                      << "'" << std::endl;
+            return -1;
+        }
+
+        // Apart from the puzzles' streams and the seed grids of the generator
+        Random random(options.seed, GridGenerator::SEED_STREAM - 1);
+        masks.push_back(makeClueMask(random, options.clues, symmetry));
+    } else {
+        PuzzleReader reader;
+        if (!reader.open(options.input_path)) { return -1; }
+
+        Cells cells;
+        ReadStatus status;
+        while ((status = reader.next(cells)) != READ_END) {
+            if (status == READ_OK) { masks.push_back(getClueMask(cells)); }
+        }
+    }
+
+    for (const ClueMask &mask : masks) {
+        if (mask.count() < MIN_PATTERN_CLUES) {
+            std::cerr << "Failed to generate puzzles: patterns need at least " << MIN_PATTERN_CLUES
+                      << " clues" << std::endl;
+            return -1;
+        }
+    }
+
+    PatternGenerator generator(options.threads);
+    std::vector<PackedBoard> puzzles;
+    std::string buffer;
+    size_t missed = 0;
+    for (size_t i = 0; i < masks.size(); i++) {
+        const auto start = Clock::now();
+        generator.resetStats();
+        const size_t found   = generator.generate(masks[i], options.count, options.seed, puzzles);
+        const double seconds = secondsSince(start);
+        missed += options.count - found;
+
+        for (const PackedBoard &packed : puzzles) { appendCells(packed, buffer); }
+
+        const PatternStats &stats = generator.getStats();
+        std::fprintf(stderr,
+                     "Pattern %zu (%u clues): %zu of %zu puzzles in %.3f s (%.0f puzzles/min)\n"
+                     "  %.2f fillings and %.1f moves per puzzle, %.1f%% of moves left no solution\n",
+                     i + 1,
+                     masks[i].count(),
+                     found,
+                     options.count,
+                     seconds,
+                     found * 60 / seconds,
+                     found ? double(stats.fillings) / found : 0.0,
+                     found ? double(stats.moves) / found : 0.0,
+                     stats.moves ? 100.0 * stats.rejected / stats.moves : 0.0);
+    }
+
+    if (!writeOutput(options.output_path, buffer, "puzzles")) { return -1; }
+    return missed == 0 ? 0 : 1;
+}
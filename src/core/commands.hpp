@@ -0,0 +1,43 @@
+#ifndef COMMANDS_HPP
+#define COMMANDS_HPP
+
+// Headless modes of the `Sudoku` binary. `args` are the arguments after the mode flag, every
+// command returns the exit code. Input defaults to standard input and output to standard output,
+// `-o` sets the output file and `-j` the number of threads.
+
+// `Sudoku --solve [input] [-o output] [-j threads]`: solves one puzzle per line and writes one
+// solution per line. Throughput and latency percentiles are reported on standard error. A binary
+// corpus is solved straight out of its mapping.
+int runSolveCommand(int arg_count, char **args);
+
+// `Sudoku --corpus [input] -o output [-j threads]`: converts a puzzle file into a binary corpus,
+// with the clue count, difficulty score and solution of every valid puzzle, see `Corpus`
+int runCorpusCommand(int arg_count, char **args);
+
+// `Sudoku --archive [input] -o output`: compresses a puzzle file into an archive, see `Archive`.
+// `Sudoku --unarchive input [-o output] [-j threads]` decodes it back into one puzzle per line.
+int runArchiveCommand(int arg_count, char **args);
+int runUnarchiveCommand(int arg_count, char **args);
+
+// `Sudoku --rate [input] [-o output] [-j threads]`: writes every puzzle with its difficulty, see
+// `DifficultyRater::rateFile`
+int runRateCommand(int arg_count, char **args);
+
+// `Sudoku --generate [-n count] [--clues count] [--seed seed] [-o output] [-j threads]`: writes
+// `count` new puzzles with a unique solution, minimal ones unless `--clues` asks for a clue
+// count. The same seed always gives the same puzzles.
+int runGenerateCommand(int arg_count, char **args);
+
+// `Sudoku --grids [-n count] [--independent] [--seed seed] [-o output] [-j threads]`: writes
+// `count` complete grids, see `GridGenerator`. `--independent` solves a new seed grid for every
+// output instead of relabeling a fixed pool of them.
+int runGridsCommand(int arg_count, char **args);
+
+// `Sudoku --pattern [patterns] [--symmetry name --clues count] [-n count] [--seed seed]
+// [-o output] [-j threads]`: writes `count` puzzles for every clue layout, see
+// `PatternGenerator`. Layouts are read in the puzzle format, where every non-zero cell is a clue,
+// or `--symmetry` makes a random one with `--clues` clues. Puzzles per minute are reported for
+// every layout.
+int runPatternCommand(int arg_count, char **args);
+
+#endif // COMMANDS_HPP
@@ -0,0 +1,136 @@
+#include "corpus.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static constexpr uint64_t alignSection(uint64_t offset) { return (offset + 7) & ~uint64_t(7); }
+
+bool Corpus::isCorpus(const char *path) {
+    char magic[sizeof(MAGIC)];
+    std::ifstream input(path, std::ios::binary);
+    return input.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool Corpus::open(const char *path) {
+    this->close();
+    if (!this->file.open(path)) { return false; }
+
+    const char *data           = this->file.getData();
+    const size_t size          = this->file.getSize();
+    const CorpusHeader *header = (const CorpusHeader *)data;
+    if (size < sizeof(CorpusHeader) || std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << "Failed to read corpus '" << path << "': not a corpus file" << std::endl;
+        this->close();
+        return false;
+    }
+
+    if (header->version != VERSION) {
+        std::cerr << "Failed to read corpus '" << path << "': unsupported version "
+                  << header->version << std::endl;
+        this->close();
+        return false;
+    }
+
+    // Every section must fit in the file and be aligned for its type
+    const auto fits = [&](uint64_t offset, uint64_t count, uint64_t element) {
+        return offset % 8 == 0 && offset <= size && count <= (size - offset) / element;
+    };
+    const bool has_info      = header->flags & CORPUS_HAS_INFO;
+    const bool has_solutions = header->flags & CORPUS_HAS_SOLUTIONS;
+    if (!fits(header->puzzles_offset, header->count, sizeof(PackedBoard))
+        || (has_info && !fits(header->info_offset, header->count, sizeof(PuzzleInfo)))
+        || (has_solutions
+            && !fits(header->solutions_offset, header->solution_count, sizeof(PackedBoard)))) {
+        std::cerr << "Failed to read corpus '" << path << "': truncated file" << std::endl;
+        this->close();
+        return false;
+    }
+
+    this->header    = header;
+    this->puzzles   = (const PackedBoard *)(data + header->puzzles_offset);
+    this->info      = has_info ? (const PuzzleInfo *)(data + header->info_offset) : nullptr;
+    this->solutions = has_solutions ? (const PackedBoard *)(data + header->solutions_offset)
+                                    : nullptr;
+    return true;
+}
+
+void Corpus::close() {
+    this->file.close();
+
+    this->header    = nullptr;
+    this->puzzles   = nullptr;
+    this->info      = nullptr;
+    this->solutions = nullptr;
+}
+
+size_t Corpus::getCount() const { return this->header ? this->header->count : 0; }
+
+uint32_t Corpus::getFlags() const { return this->header ? this->header->flags : 0; }
+
+const PackedBoard &Corpus::getPuzzle(size_t index) const { return this->puzzles[index]; }
+
+const PackedBoard *Corpus::getPuzzles() const { return this->puzzles; }
+
+const PuzzleInfo *Corpus::getInfo(size_t index) const {
+    return this->info ? &this->info[index] : nullptr;
+}
+
+const PackedBoard *Corpus::getSolution(size_t index) const {
+    if (!this->info || !this->solutions) { return nullptr; }
+
+    const uint32_t solution = this->info[index].solution;
+    if (solution == PuzzleInfo::NO_SOLUTION || solution >= this->header->solution_count) {
+        return nullptr;
+    }
+
+    return &this->solutions[solution];
+}
+
+bool Corpus::write(const char *path,
+                   const std::vector<PackedBoard> &puzzles,
+                   const std::vector<PuzzleInfo> &info,
+                   const std::vector<PackedBoard> &solutions) {
+    if (!info.empty() && info.size() != puzzles.size()) {
+        std::cerr << "Failed to write corpus '" << path << "': " << info.size()
+                  << " metadata records for " << puzzles.size() << " puzzles" << std::endl;
+        return false;
+    }
+
+    CorpusHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version        = VERSION;
+    header.count          = puzzles.size();
+    header.solution_count = solutions.size();
+    if (!info.empty()) { header.flags |= CORPUS_HAS_INFO; }
+    if (!solutions.empty()) { header.flags |= CORPUS_HAS_SOLUTIONS; }
+
+    header.puzzles_offset   = alignSection(sizeof(CorpusHeader));
+    header.info_offset      = alignSection(header.puzzles_offset
+                                      + puzzles.size() * sizeof(PackedBoard));
+    header.solutions_offset = alignSection(header.info_offset + info.size() * sizeof(PuzzleInfo));
+
+    std::ofstream output(path, std::ios::binary);
+    const auto writeSection = [&](uint64_t offset, const void *data, size_t size) {
+        static constexpr char padding[8] = {};
+        // `tellp` is -1 once a write failed, the error is reported below
+        if (!output) { return; }
+
+        output.write(padding, offset - output.tellp());
+        output.write((const char *)data, size);
+    };
+
+    output.write((const char *)&header, sizeof(header));
+    writeSection(header.puzzles_offset, puzzles.data(), puzzles.size() * sizeof(PackedBoard));
+    writeSection(header.info_offset, info.data(), info.size() * sizeof(PuzzleInfo));
+    writeSection(header.solutions_offset,
+                 solutions.data(),
+                 solutions.size() * sizeof(PackedBoard));
+
+    if (!output) {
+        std::cerr << "Failed to write corpus '" << path << "'" << std::endl;
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,80 @@
+#ifndef CORPUS_HPP
+#define CORPUS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "mapped_file.hpp"
+#include "packed_board.hpp"
+
+// Binary puzzle corpus. The file is a `CorpusHeader` followed by `count` packed puzzles and,
+// depending on `flags`, one `PuzzleInfo` per puzzle and the packed solutions. Every section
+// starts at an 8 byte aligned offset. Numbers are little-endian.
+enum CorpusFlags : uint32_t {
+    CORPUS_HAS_INFO      = 1 << 0,
+    CORPUS_HAS_SOLUTIONS = 1 << 1,
+};
+
+struct CorpusHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t count;
+    uint64_t puzzles_offset;
+    uint64_t info_offset;
+    uint64_t solution_count;
+    uint64_t solutions_offset;
+};
+
+struct PuzzleInfo {
+    static constexpr uint32_t NO_SOLUTION = UINT32_MAX;
+
+    uint16_t difficulty;
+    uint8_t clue_count;
+    uint8_t reserved;
+    // Index into the solutions section
+    uint32_t solution;
+};
+
+static_assert(sizeof(CorpusHeader) == 56);
+static_assert(sizeof(PuzzleInfo) == 8);
+
+// Maps a corpus file and hands out puzzles straight from the mapping, so opening a corpus costs
+// the same no matter how many puzzles it has and any puzzle can be read at once.
+class Corpus {
+public:
+    static constexpr char MAGIC[8]    = {'S', 'U', 'D', 'O', 'K', 'U', 'C', '\0'};
+    static constexpr uint32_t VERSION = 1;
+
+    // Whether `path` starts with the corpus magic, so tools can take text or corpus input
+    static bool isCorpus(const char *path);
+
+    bool open(const char *path);
+    void close();
+
+    size_t getCount() const;
+    uint32_t getFlags() const;
+    const PackedBoard &getPuzzle(size_t index) const;
+    const PackedBoard *getPuzzles() const;
+    // Null when the corpus has no metadata
+    const PuzzleInfo *getInfo(size_t index) const;
+    // Null when the puzzle has no stored solution
+    const PackedBoard *getSolution(size_t index) const;
+
+    // `info` and `solutions` may be empty, every info points into `solutions` or has
+    // `PuzzleInfo::NO_SOLUTION`.
+    static bool write(const char *path,
+                      const std::vector<PackedBoard> &puzzles,
+                      const std::vector<PuzzleInfo> &info,
+                      const std::vector<PackedBoard> &solutions);
+
+private:
+    MappedFile file;
+    const CorpusHeader *header   = nullptr;
+    const PackedBoard *puzzles   = nullptr;
+    const PuzzleInfo *info       = nullptr;
+    const PackedBoard *solutions = nullptr;
+};
+
+#endif // CORPUS_HPP
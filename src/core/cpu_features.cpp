@@ -0,0 +1,39 @@
+#include "cpu_features.hpp"
+
+#include <cstring>
+#include <initializer_list>
+
+SimdLevel detectSimdLevel() {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return SIMD_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) { return SIMD_AVX2; }
+    if (__builtin_cpu_supports("sse4.2")) { return SIMD_SSE42; }
+#endif
+
+    return SIMD_SCALAR;
+}
+
+const char *getSimdLevelName(SimdLevel level) {
+    switch (level) {
+        case SIMD_SCALAR: return "scalar";
+        case SIMD_SSE42: return "sse4.2";
+        case SIMD_AVX2: return "avx2";
+        case SIMD_AVX512: return "avx512";
+    }
+
+    return "unknown";
+}
+
+bool parseSimdLevel(const char *name, SimdLevel &level) {
+    for (SimdLevel l : {SIMD_SCALAR, SIMD_SSE42, SIMD_AVX2, SIMD_AVX512}) {
+        if (std::strcmp(name, getSimdLevelName(l)) == 0) {
+            level = l;
+            return true;
+        }
+    }
+
+    return false;
+}
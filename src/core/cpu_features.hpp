@@ -0,0 +1,27 @@
+#ifndef CPU_FEATURES_HPP
+#define CPU_FEATURES_HPP
+
+// Lets a single function use a wider instruction set than the rest of the binary. Callers must
+// make sure the CPU supports it, see `detectSimdLevel`.
+#if defined(__GNUC__) || defined(__clang__)
+    #define TARGET_SSE42  __attribute__((target("sse4.2")))
+    #define TARGET_AVX2   __attribute__((target("avx2")))
+    #define TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#else
+    #define TARGET_SSE42
+    #define TARGET_AVX2
+    #define TARGET_AVX512
+#endif
+
+enum SimdLevel {
+    SIMD_SCALAR,
+    SIMD_SSE42,
+    SIMD_AVX2,
+    SIMD_AVX512,
+};
+
+SimdLevel detectSimdLevel();
+const char *getSimdLevelName(SimdLevel level);
+bool parseSimdLevel(const char *name, SimdLevel &level);
+
+#endif // CPU_FEATURES_HPP
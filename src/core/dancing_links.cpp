@@ -0,0 +1,194 @@
+#include "dancing_links.hpp"
+
+#include "tables.hpp"
+
+// Node 0 is the root, nodes 1-324 are column headers and every candidate (cell, digit) owns
+// four consecutive nodes after them.
+static constexpr unsigned int ROOT         = 0;
+static constexpr unsigned int FIRST_COLUMN = 1;
+
+static constexpr unsigned int rowNode(unsigned int candidate) {
+    return FIRST_COLUMN + 4 * 9 * 9 + candidate * 4;
+}
+
+DancingLinks::DancingLinks() {
+    for (unsigned int c = 0; c <= COLUMN_COUNT; c++) {
+        this->left[c]   = c == 0 ? COLUMN_COUNT : c - 1;
+        this->right[c]  = c == COLUMN_COUNT ? 0 : c + 1;
+        this->up[c]     = c;
+        this->down[c]   = c;
+        this->column[c] = c;
+        this->row[c]    = 0;
+        this->size[c]   = 0;
+    }
+
+    for (unsigned int candidate = 0; candidate < ROW_COUNT; candidate++) {
+        const unsigned int cell  = candidate / 9;
+        const unsigned int digit = candidate % 9;
+        const auto &units        = CELL_UNITS[cell];
+
+        // Row, column and box constraints follow the unit numbering of the tables
+        const std::array<unsigned int, 4> columns = {
+            FIRST_COLUMN + cell,
+            FIRST_COLUMN + 81 + units[0] * 9 + digit,
+            FIRST_COLUMN + 81 + units[1] * 9 + digit,
+            FIRST_COLUMN + 81 + units[2] * 9 + digit,
+        };
+
+        const unsigned int first = rowNode(candidate);
+        for (unsigned int i = 0; i < 4; i++) {
+            const unsigned int node = first + i;
+            const unsigned int col  = columns[i];
+
+            this->left[node]   = first + (i + 3) % 4;
+            this->right[node]  = first + (i + 1) % 4;
+            this->column[node] = col;
+            this->row[node]    = candidate;
+
+            this->up[node]            = this->up[col];
+            this->down[node]          = col;
+            this->down[this->up[col]] = node;
+            this->up[col]             = node;
+            this->size[col]++;
+        }
+    }
+}
+
+unsigned int DancingLinks::countSolutions(const Cells &puzzle, unsigned int limit) {
+    return this->enumerate(puzzle, limit, {});
+}
+
+unsigned int DancingLinks::enumerate(const Cells &puzzle,
+                                     unsigned int limit,
+                                     const std::function<bool(const Cells &)> &callback) {
+    this->stats          = {};
+    this->solution_count = 0;
+    this->solution_limit = limit;
+    this->callback       = &callback;
+    this->stopped        = false;
+    this->selected_count = 0;
+    this->current        = puzzle;
+
+    // Remove the rows of the givens from the matrix; a given whose columns are already gone
+    // conflicts with an earlier one.
+    std::array<uint16_t, 9 * 9> givens;
+    unsigned int given_count = 0;
+    bool valid               = true;
+    for (unsigned int cell = 0; cell < 9 * 9 && valid; cell++) {
+        if (puzzle[cell] == 0) { continue; }
+        if (puzzle[cell] > 9) {
+            valid = false;
+            break;
+        }
+
+        const unsigned int node = rowNode(cell * 9 + puzzle[cell] - 1);
+        for (unsigned int j = node;;) {
+            const unsigned int col = this->column[j];
+            if (this->right[this->left[col]] != col) { valid = false; }
+
+            j = this->right[j];
+            if (j == node) { break; }
+        }
+        if (!valid) { break; }
+
+        for (unsigned int j = node;;) {
+            this->cover(this->column[j]);
+
+            j = this->right[j];
+            if (j == node) { break; }
+        }
+        givens[given_count++] = node;
+    }
+
+    if (valid && limit > 0) { this->search(); }
+
+    while (given_count > 0) {
+        const unsigned int node = givens[--given_count];
+        for (unsigned int j = this->left[node];; j = this->left[j]) {
+            this->uncover(this->column[j]);
+            if (j == node) { break; }
+        }
+    }
+
+    return this->solution_count;
+}
+
+const SolverStats &DancingLinks::getStats() const { return this->stats; }
+
+void DancingLinks::cover(unsigned int c) {
+    this->left[this->right[c]] = this->left[c];
+    this->right[this->left[c]] = this->right[c];
+
+    for (unsigned int i = this->down[c]; i != c; i = this->down[i]) {
+        for (unsigned int j = this->right[i]; j != i; j = this->right[j]) {
+            this->up[this->down[j]] = this->up[j];
+            this->down[this->up[j]] = this->down[j];
+            this->size[this->column[j]]--;
+        }
+    }
+}
+
+void DancingLinks::uncover(unsigned int c) {
+    for (unsigned int i = this->up[c]; i != c; i = this->up[i]) {
+        for (unsigned int j = this->left[i]; j != i; j = this->left[j]) {
+            this->size[this->column[j]]++;
+            this->up[this->down[j]] = j;
+            this->down[this->up[j]] = j;
+        }
+    }
+
+    this->left[this->right[c]] = c;
+    this->right[this->left[c]] = c;
+}
+
+void DancingLinks::search() {
+    this->stats.nodes++;
+
+    if (this->right[ROOT] == ROOT) {
+        this->solution_count++;
+
+        if (*this->callback) {
+            Cells solution = this->current;
+            for (unsigned int i = 0; i < this->selected_count; i++) {
+                const unsigned int candidate = this->selected[i];
+                solution[candidate / 9]      = candidate % 9 + 1;
+            }
+
+            if (!(*this->callback)(solution)) { this->stopped = true; }
+        }
+
+        if (this->solution_count >= this->solution_limit) { this->stopped = true; }
+        return;
+    }
+
+    // Branch on the column with the fewest remaining rows
+    unsigned int best      = this->right[ROOT];
+    unsigned int best_size = this->size[best];
+    for (unsigned int c = this->right[best]; c != ROOT && best_size > 1; c = this->right[c]) {
+        if (this->size[c] < best_size) {
+            best      = c;
+            best_size = this->size[c];
+        }
+    }
+
+    if (best_size == 0) {
+        this->stats.backtracks++;
+        return;
+    }
+
+    this->cover(best);
+    for (unsigned int i = this->down[best]; i != best && !this->stopped; i = this->down[i]) {
+        this->selected[this->selected_count++] = this->row[i];
+        for (unsigned int j = this->right[i]; j != i; j = this->right[j]) {
+            this->cover(this->column[j]);
+        }
+
+        this->search();
+
+        for (unsigned int j = this->left[i]; j != i; j = this->left[j]) {
+            this->uncover(this->column[j]);
+        }
+        this->selected_count--;
+    }
+    this->uncover(best);
+}
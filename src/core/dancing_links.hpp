@@ -0,0 +1,48 @@
+#ifndef DANCING_LINKS_HPP
+#define DANCING_LINKS_HPP
+
+#include <array>
+#include <cstdint>
+#include <functional>
+
+#include "board.hpp"
+#include "solver.hpp"
+
+// Algorithm X on the 324-column exact cover matrix of a 9x9 board (cell, row-digit,
+// column-digit and box-digit constraints). All nodes live in fixed arrays and are linked by
+// index, so a single instance can be reused for any number of puzzles without allocating.
+class DancingLinks {
+public:
+    DancingLinks();
+
+    unsigned int countSolutions(const Cells &puzzle, unsigned int limit);
+    unsigned int enumerate(const Cells &puzzle,
+                           unsigned int limit,
+                           const std::function<bool(const Cells &)> &callback);
+
+    const SolverStats &getStats() const;
+
+private:
+    static constexpr unsigned int COLUMN_COUNT = 4 * 9 * 9;
+    static constexpr unsigned int ROW_COUNT    = 9 * 9 * 9;
+    static constexpr unsigned int NODE_COUNT   = 1 + COLUMN_COUNT + 4 * ROW_COUNT;
+
+    std::array<uint16_t, NODE_COUNT> left, right, up, down, column;
+    std::array<uint16_t, NODE_COUNT> row;
+    std::array<uint16_t, COLUMN_COUNT + 1> size;
+
+    std::array<uint16_t, 9 * 9> selected;
+    unsigned int selected_count;
+    Cells current;
+    SolverStats stats;
+    unsigned int solution_count;
+    unsigned int solution_limit;
+    const std::function<bool(const Cells &)> *callback;
+    bool stopped;
+
+    void cover(unsigned int c);
+    void uncover(unsigned int c);
+    void search();
+};
+
+#endif // DANCING_LINKS_HPP
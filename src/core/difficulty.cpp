@@ -0,0 +1,126 @@
+#include "difficulty.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+#include "output_file.hpp"
+#include "puzzle_reader.hpp"
+
+static constexpr uint16_t MAX_EFFORT = 999;
+
+// The harder technique of the tier
+static constexpr Technique TIER_LIMITS[] = {
+    TECHNIQUE_NAKED_SINGLE,
+    TECHNIQUE_LOCKED_CANDIDATES,
+    TECHNIQUE_HIDDEN_TRIPLE,
+    TECHNIQUE_SWORDFISH,
+};
+
+const char *getDifficultyName(Difficulty difficulty) {
+    switch (difficulty) {
+        case DIFFICULTY_EASY: return "easy";
+        case DIFFICULTY_MEDIUM: return "medium";
+        case DIFFICULTY_HARD: return "hard";
+        case DIFFICULTY_EXPERT: return "expert";
+        case DIFFICULTY_EXTREME: return "extreme";
+        default: return "unknown";
+    }
+}
+
+const char *getHardestName(const Rating &rating) {
+    return rating.hardest == TECHNIQUE_COUNT ? "needs_search" : getTechniqueName(rating.hardest);
+}
+
+Rating ratePuzzle(LogicalSolver &solver, const Cells &puzzle) {
+    const bool solved = solver.solve(puzzle);
+
+    // Every step costs one more than the technique before it, so harder traces weigh more
+    Technique hardest   = TECHNIQUE_HIDDEN_SINGLE;
+    unsigned int effort = 0;
+    for (const LogicalStep &step : solver.getSteps()) {
+        hardest = std::max(hardest, step.technique);
+        effort += step.technique + 1;
+    }
+    if (!solved) { hardest = TECHNIQUE_COUNT; }
+
+    Rating rating;
+    rating.score      = (hardest + 1) * 1000 + std::min<unsigned int>(effort, MAX_EFFORT);
+    rating.steps      = solver.getSteps().size();
+    rating.hardest    = hardest;
+    rating.difficulty = DIFFICULTY_EXTREME;
+    for (unsigned int tier = 0; tier < std::size(TIER_LIMITS); tier++) {
+        if (hardest <= TIER_LIMITS[tier]) {
+            rating.difficulty = Difficulty(tier);
+            break;
+        }
+    }
+
+    return rating;
+}
+
+DifficultyRater::DifficultyRater(unsigned int threads)
+    : own_pool(std::make_unique<ThreadPool>(threads)), pool(*this->own_pool) {
+    this->solvers.resize(this->pool.getThreadCount() + 1);
+}
+
+DifficultyRater::DifficultyRater(ThreadPool &pool): pool(pool) {
+    this->solvers.resize(this->pool.getThreadCount() + 1);
+}
+
+void DifficultyRater::rate(const std::vector<PackedBoard> &puzzles, std::vector<Rating> &ratings) {
+    ratings.resize(puzzles.size());
+
+    this->pool.parallelFor(puzzles.size(), CHUNK_SIZE, [&](size_t begin, size_t end) {
+        LogicalSolver &solver = this->solvers[this->pool.getWorkerIndex()];
+        Cells puzzle;
+        for (size_t i = begin; i < end; i++) {
+            unpackCells(puzzles[i], puzzle);
+            ratings[i] = ratePuzzle(solver, puzzle);
+        }
+    });
+}
+
+bool DifficultyRater::rateFile(const char *input_path, const char *output_path) {
+    PuzzleReader reader;
+    OutputFile output;
+    if (!reader.open(input_path) || !output.open(output_path, "ratings")) { return false; }
+
+    std::vector<PackedBoard> puzzles;
+    std::vector<Rating> ratings;
+    std::string buffer;
+    char fields[64];
+    Cells cells;
+    ReadStatus status = READ_OK;
+    while (status != READ_END) {
+        // Reads, rates and writes one batch at a time, so memory stays bounded on any input
+        puzzles.clear();
+        while (puzzles.size() < BATCH_SIZE && (status = reader.next(cells)) != READ_END) {
+            if (status == READ_OK) { packCells(cells, puzzles.emplace_back()); }
+        }
+
+        this->rate(puzzles, ratings);
+
+        buffer.clear();
+        for (size_t i = 0; i < puzzles.size(); i++) {
+            unpackCells(puzzles[i], cells);
+            for (uint8_t digit : cells) { buffer.push_back('0' + digit); }
+
+            const Rating &rating = ratings[i];
+            std::snprintf(fields,
+                          sizeof(fields),
+                          " %05u %s %s %u\n",
+                          rating.score,
+                          getDifficultyName(rating.difficulty),
+                          getHardestName(rating),
+                          rating.steps);
+            buffer += fields;
+        }
+
+        if (!output.write(buffer)) { return false; }
+    }
+
+    return output.close();
+}
+
+ThreadPool &DifficultyRater::getPool() { return this->pool; }
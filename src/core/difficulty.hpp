@@ -0,0 +1,72 @@
+#ifndef DIFFICULTY_HPP
+#define DIFFICULTY_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "logical_solver.hpp"
+#include "packed_board.hpp"
+#include "thread_pool.hpp"
+
+// Tiers by the hardest technique a puzzle needs. Extreme puzzles need more than
+// `LogicalSolver` knows, or have no unique solution at all.
+enum Difficulty {
+    DIFFICULTY_EASY,
+    DIFFICULTY_MEDIUM,
+    DIFFICULTY_HARD,
+    DIFFICULTY_EXPERT,
+    DIFFICULTY_EXTREME,
+    DIFFICULTY_COUNT,
+};
+
+const char *getDifficultyName(Difficulty difficulty);
+
+struct Rating {
+    // `(hardest + 1) * 1000` plus the effort of all steps, capped at 999. Higher is harder, it
+    // sorts puzzles by tier first and fits `PuzzleInfo::difficulty`.
+    uint16_t score;
+    uint16_t steps;
+    // `TECHNIQUE_COUNT` when the techniques were not enough
+    Technique hardest;
+    Difficulty difficulty;
+};
+
+// Name of `rating.hardest`, `needs_search` when the techniques were not enough
+const char *getHardestName(const Rating &rating);
+
+// Solves `puzzle` with logical steps only and rates the trace
+Rating ratePuzzle(LogicalSolver &solver, const Cells &puzzle);
+
+// Rates many puzzles on a thread pool, every worker keeps its own `LogicalSolver` across calls.
+// One rater must not be used from several threads at once.
+class DifficultyRater {
+public:
+    explicit DifficultyRater(unsigned int threads = 0);
+    // Rates on the workers of `pool`, which must outlive the rater
+    explicit DifficultyRater(ThreadPool &pool);
+
+    void rate(const std::vector<PackedBoard> &puzzles, std::vector<Rating> &ratings);
+
+    // Copies every valid puzzle of `input_path` to `output_path` followed by its score,
+    // difficulty, hardest technique and step count, e.g.
+    // `<81 digits> 03041 medium locked_candidates 59`, see `getHardestName`. Scores are
+    // zero-padded so the lines sort as text too, and the output can be read back as a puzzle
+    // file. Puzzles are streamed in batches of `BATCH_SIZE`, so any input size works in bounded
+    // memory.
+    bool rateFile(const char *input_path, const char *output_path);
+
+    ThreadPool &getPool();
+
+private:
+    static constexpr size_t CHUNK_SIZE = 256;
+    static constexpr size_t BATCH_SIZE = 1 << 16;
+
+    // Null when the rater runs on a pool it was given
+    std::unique_ptr<ThreadPool> own_pool;
+    ThreadPool &pool;
+    // Indexed by `ThreadPool::getWorkerIndex`, the last one is for the calling thread
+    std::vector<LogicalSolver> solvers;
+};
+
+#endif // DIFFICULTY_HPP
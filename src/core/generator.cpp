@@ -0,0 +1,96 @@
+#include "generator.hpp"
+
+#include <atomic>
+#include <numeric>
+
+PuzzleGenerator::PuzzleGenerator(unsigned int threads): pool(threads) { }
+
+size_t PuzzleGenerator::generate(size_t count,
+                                 uint64_t seed,
+                                 unsigned int target_clues,
+                                 std::vector<PackedBoard> &puzzles) {
+    puzzles.resize(count);
+
+    std::atomic<size_t> met      = 0;
+    std::atomic<uint64_t> grids  = 0;
+    std::atomic<uint64_t> checks = 0;
+    this->pool.parallelFor(count, 1, [&](size_t begin, size_t end) {
+        Solver<3, 3> solver;
+        GeneratorStats stats;
+        Cells puzzle;
+
+        for (size_t i = begin; i < end; i++) {
+            Random random(seed, i);
+            met += generateOne(random, target_clues, solver, puzzle, stats);
+            packCells(puzzle, puzzles[i]);
+        }
+
+        grids += stats.grids;
+        checks += stats.checks;
+    });
+
+    this->stats.grids += grids;
+    this->stats.checks += checks;
+    return met;
+}
+
+const GeneratorStats &PuzzleGenerator::getStats() const { return this->stats; }
+
+ThreadPool &PuzzleGenerator::getPool() { return this->pool; }
+
+bool PuzzleGenerator::generateOne(Random &random,
+                                  unsigned int target_clues,
+                                  Solver<3, 3> &solver,
+                                  Cells &puzzle,
+                                  GeneratorStats &stats) {
+    Cells grid, best;
+    unsigned int best_clues = 9 * 9 + 1;
+    std::array<uint8_t, 9 * 9> order;
+
+    for (unsigned int attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
+        fillGrid(random, solver, grid);
+        stats.grids++;
+
+        puzzle             = grid;
+        unsigned int clues = 9 * 9;
+        std::iota(order.begin(), order.end(), 0);
+        random.shuffle(order.data(), order.size());
+
+        for (unsigned int cell : order) {
+            if (clues == target_clues) { break; }
+
+            puzzle[cell] = 0;
+            stats.checks++;
+            if (solver.countSolutions(puzzle, 2) == 1) {
+                clues--;
+            } else {
+                puzzle[cell] = grid[cell];
+            }
+        }
+
+        if (clues <= target_clues || target_clues == 0) { return true; }
+
+        if (clues < best_clues) {
+            best       = puzzle;
+            best_clues = clues;
+        }
+    }
+
+    puzzle = best;
+    return false;
+}
+
+void PuzzleGenerator::fillGrid(Random &random, Solver<3, 3> &solver, Cells &grid) {
+    // The diagonal boxes share no unit, so any digits go, and the solver fills the rest
+    grid = {};
+    for (unsigned int box = 0; box < 9; box += 4) {
+        uint8_t digits[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+        random.shuffle(digits, 9);
+        for (unsigned int i = 0; i < 9; i++) {
+            grid[BoardGeometry<3, 3>::boxCell(box, i)] = digits[i];
+        }
+    }
+
+    solver.solve(grid);
+    grid = solver.getSolution();
+}
@@ -0,0 +1,60 @@
+#ifndef GENERATOR_HPP
+#define GENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "board.hpp"
+#include "packed_board.hpp"
+#include "random.hpp"
+#include "solver.hpp"
+#include "thread_pool.hpp"
+
+// Clue counts below this are out of reach for random removal in any reasonable time
+static constexpr unsigned int MIN_TARGET_CLUES = 20;
+
+struct GeneratorStats {
+    // Full grids dug out, more than the puzzle count when targets were missed
+    uint64_t grids = 0;
+    // Uniqueness checks run while removing clues
+    uint64_t checks = 0;
+};
+
+// Makes puzzles with exactly one solution: fills a random grid, then removes clues in random
+// order and puts back every one whose removal allows a second solution, which the solver finds
+// without searching past it. Puzzle `i` of a run is made from its own random stream
+// `Random(seed, i)`, so a seed gives the same puzzles on any number of threads.
+class PuzzleGenerator {
+public:
+    explicit PuzzleGenerator(unsigned int threads = 0);
+
+    // `target_clues` stops removing once the puzzle is down to that many clues and starts over
+    // from a new grid when a minimal puzzle still has more, up to `MAX_ATTEMPTS` grids. 0 asks
+    // for minimal puzzles, where no clue can be removed. Returns how many puzzles met the target.
+    size_t generate(size_t count,
+                    uint64_t seed,
+                    unsigned int target_clues,
+                    std::vector<PackedBoard> &puzzles);
+
+    const GeneratorStats &getStats() const;
+    ThreadPool &getPool();
+
+    // Single puzzle on the calling thread, returns whether it met the target
+    static bool generateOne(Random &random,
+                            unsigned int target_clues,
+                            Solver<3, 3> &solver,
+                            Cells &puzzle,
+                            GeneratorStats &stats);
+
+    // Random complete grid
+    static void fillGrid(Random &random, Solver<3, 3> &solver, Cells &grid);
+
+private:
+    static constexpr unsigned int MAX_ATTEMPTS = 64;
+
+    ThreadPool pool;
+    GeneratorStats stats;
+};
+
+#endif // GENERATOR_HPP
@@ -0,0 +1,40 @@
+#ifndef GEOMETRY_HPP
+#define GEOMETRY_HPP
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+// Sizes and index math of a board made of `BoxRows` x `BoxCols` boxes, e.g. 3x3 boxes for the
+// classic 9x9 board or 2x3 boxes for 6x6. Everything is known at compile time, so divisions
+// by the board size turn into multiplications.
+template <unsigned int BoxRows, unsigned int BoxCols>
+struct BoardGeometry {
+    static constexpr unsigned int SIZE       = BoxRows * BoxCols;
+    static constexpr unsigned int CELL_COUNT = SIZE * SIZE;
+    static constexpr unsigned int UNIT_COUNT = 3 * SIZE;
+
+    // One bit per digit, bit `n - 1` for digit `n`
+    using Mask = std::conditional_t<(SIZE <= 16), uint16_t, uint32_t>;
+    // Plain digits of a board in row-major order, 0 for empty cells
+    using Cells = std::array<uint8_t, CELL_COUNT>;
+
+    static constexpr Mask ALL_DIGITS = (uint32_t(1) << SIZE) - 1;
+
+    static constexpr unsigned int row(unsigned int cell) { return cell / SIZE; }
+    static constexpr unsigned int column(unsigned int cell) { return cell % SIZE; }
+    static constexpr unsigned int box(unsigned int cell) {
+        return (row(cell) / BoxRows) * BoxRows + column(cell) / BoxCols;
+    }
+
+    static constexpr unsigned int boxCell(unsigned int box, unsigned int i) {
+        return ((box / BoxRows) * BoxRows + i / BoxCols) * SIZE + (box % BoxRows) * BoxCols
+             + i % BoxCols;
+    }
+
+    static_assert(SIZE >= 4 && SIZE <= 25, "Digits must fit in a byte and a 32-bit mask");
+};
+
+using Cells = BoardGeometry<3, 3>::Cells;
+
+#endif // GEOMETRY_HPP
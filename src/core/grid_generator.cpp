@@ -0,0 +1,166 @@
+#include "grid_generator.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <immintrin.h>
+
+#include "cpu_features.hpp"
+#include "generator.hpp"
+#include "kernels.hpp"
+
+void transformGrid(const SeedGrid &source, const GridTransform &transform, Cells &grid) {
+    Kernels::get().transformGrid(source, transform, grid);
+}
+
+void transformGridScalar(const SeedGrid &source, const GridTransform &transform, Cells &grid) {
+    for (unsigned int row = 0; row < 9; row++) {
+        const uint8_t *source_row = &source.cells[transform.rows[row] * 9];
+        for (unsigned int column = 0; column < 9; column++) {
+            grid[row * 9 + column] = transform.digits[source_row[transform.columns[column]]];
+        }
+    }
+}
+
+// One shuffle picks the columns of a row, a second one relabels its digits. Rows are 9 bytes
+// apart, so a wider kernel would spend more on gathering them into lanes than it saves.
+TARGET_SSE42 void transformGridSse42(const SeedGrid &source,
+                                     const GridTransform &transform,
+                                     Cells &grid) {
+    const __m128i columns = _mm_load_si128((const __m128i *)transform.columns.data());
+    const __m128i digits  = _mm_load_si128((const __m128i *)transform.digits.data());
+
+    alignas(16) uint8_t buffer[96];
+    for (unsigned int row = 0; row < 9; row++) {
+        const uint8_t *source_row = &source.cells[transform.rows[row] * 9];
+        const __m128i picked      = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)source_row),
+                                                columns);
+        _mm_storeu_si128((__m128i *)&buffer[row * 9], _mm_shuffle_epi8(digits, picked));
+    }
+
+    std::memcpy(grid.data(), buffer, grid.size());
+}
+
+static constexpr uint8_t PERMUTATIONS[6][3] = {
+    {0, 1, 2},
+    {0, 2, 1},
+    {1, 0, 2},
+    {1, 2, 0},
+    {2, 0, 1},
+    {2, 1, 0},
+};
+
+// Takes a value in `[0, bound)` from the top of `bits` and leaves the rest for the next value,
+// so a single random word makes a whole shuffle without any division. Like `Random::below`,
+// each value is off from uniform by at most the product of the bounds so far over 2^32.
+static uint32_t take(uint32_t &bits, uint32_t bound) {
+    const uint64_t product = uint64_t(bits) * bound;
+    bits                   = uint32_t(product);
+    return product >> 32;
+}
+
+// Fills the 9 rows or columns of a transform: the order of the three bands or stacks, then the
+// order of the lines inside each of them
+static void randomLines(Random &random, uint8_t *lines) {
+    uint32_t bits         = random.next() >> 32;
+    const uint8_t *groups = PERMUTATIONS[take(bits, 6)];
+    for (unsigned int i = 0; i < 3; i++) {
+        const uint8_t *inside = PERMUTATIONS[take(bits, 6)];
+        for (unsigned int j = 0; j < 3; j++) { lines[i * 3 + j] = groups[i] * 3 + inside[j]; }
+    }
+}
+
+GridGenerator::GridGenerator(uint64_t seed, unsigned int seed_grids) {
+    Random random(seed, SEED_STREAM);
+    Solver<3, 3> solver;
+    Cells grid, transposed;
+
+    this->seeds.resize(2 * seed_grids);
+    for (unsigned int i = 0; i < seed_grids; i++) {
+        PuzzleGenerator::fillGrid(random, solver, grid);
+        for (unsigned int cell = 0; cell < 9 * 9; cell++) {
+            transposed[cell] = grid[(cell % 9) * 9 + cell / 9];
+        }
+
+        makeSeedGrid(grid, this->seeds[2 * i]);
+        makeSeedGrid(transposed, this->seeds[2 * i + 1]);
+    }
+}
+
+void GridGenerator::generate(Random &random, PackedBoard *grids, size_t count) const {
+    // There is nothing to relabel, `below(0)` would not be a valid draw
+    if (this->seeds.empty()) {
+        this->generateIndependent(random, grids, count);
+        return;
+    }
+
+    GridTransform transform;
+    Cells grid;
+    for (size_t i = 0; i < count; i++) {
+        randomTransform(random, transform);
+        transformGrid(this->seeds[random.below(this->seeds.size())], transform, grid);
+        packCells(grid, grids[i]);
+    }
+}
+
+void GridGenerator::generateIndependent(Random &random, PackedBoard *grids, size_t count) const {
+    Solver<3, 3> solver;
+    GridTransform transform;
+    SeedGrid seed;
+    Cells grid;
+    for (size_t i = 0; i < count; i++) {
+        PuzzleGenerator::fillGrid(random, solver, grid);
+
+        // Transposition is the only symmetry the transform does not cover
+        if (random.next() & 1) {
+            for (unsigned int row = 0; row < 9; row++) {
+                for (unsigned int column = row + 1; column < 9; column++) {
+                    std::swap(grid[row * 9 + column], grid[column * 9 + row]);
+                }
+            }
+        }
+
+        makeSeedGrid(grid, seed);
+        randomTransform(random, transform);
+        transformGrid(seed, transform, grid);
+        packCells(grid, grids[i]);
+    }
+}
+
+void GridGenerator::generate(ThreadPool &pool,
+                             uint64_t seed,
+                             bool independent,
+                             PackedBoard *grids,
+                             size_t count) const {
+    const size_t chunks = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    pool.parallelFor(chunks, 1, [&](size_t begin, size_t end) {
+        for (size_t chunk = begin; chunk < end; chunk++) {
+            Random random(seed, chunk);
+            const size_t first = chunk * CHUNK_SIZE;
+            const size_t size  = std::min(CHUNK_SIZE, count - first);
+            if (independent) {
+                this->generateIndependent(random, grids + first, size);
+            } else {
+                this->generate(random, grids + first, size);
+            }
+        }
+    });
+}
+
+void GridGenerator::randomTransform(Random &random, GridTransform &transform) {
+    randomLines(random, transform.rows.data());
+    randomLines(random, transform.columns.data());
+    // Unused shuffle lanes come out as zero
+    std::fill(transform.columns.begin() + 9, transform.columns.end(), 0x80);
+
+    uint32_t bits    = random.next() >> 32;
+    transform.digits = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    for (uint32_t i = 9; i > 1; i--) {
+        std::swap(transform.digits[i], transform.digits[take(bits, i) + 1]);
+    }
+}
+
+void GridGenerator::makeSeedGrid(const Cells &grid, SeedGrid &seed) {
+    seed.cells = {};
+    std::copy(grid.begin(), grid.end(), seed.cells.begin());
+}
@@ -0,0 +1,79 @@
+#ifndef GRID_GENERATOR_HPP
+#define GRID_GENERATOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "board.hpp"
+#include "packed_board.hpp"
+#include "random.hpp"
+#include "thread_pool.hpp"
+
+// Source grid with room for a 16 byte load at every row
+struct SeedGrid {
+    alignas(16) std::array<uint8_t, 96> cells;
+};
+
+// A validity-preserving relabeling of a grid: cell `(r, c)` of the result takes
+// `digits[source[rows[r] * 9 + columns[c]]]`. The rows and columns come from permuting bands
+// and stacks and the rows and columns inside them.
+struct GridTransform {
+    alignas(16) std::array<uint8_t, 16> columns;
+    alignas(16) std::array<uint8_t, 16> digits;
+    std::array<uint8_t, 9> rows;
+};
+
+// Applies `transform` with the kernel selected by `Kernels`
+void transformGrid(const SeedGrid &source, const GridTransform &transform, Cells &grid);
+
+void transformGridScalar(const SeedGrid &source, const GridTransform &transform, Cells &grid);
+void transformGridSse42(const SeedGrid &source, const GridTransform &transform, Cells &grid);
+
+// Makes complete grids in bulk, straight into packed boards.
+//
+// Every grid is a random element of the symmetry group (band, stack, row and column
+// permutations, transposition and digit relabeling, 3!^8 * 2 * 9! elements) applied to a seed
+// grid, so each grid is uniform among the grids equivalent to its seed. `generate` draws the
+// seed from a fixed pool and makes millions of grids per second, but only ever reaches the
+// equivalence classes of the pool. `generateIndependent` fills a new seed grid for every
+// output, which reaches every class, at the speed of the solver.
+//
+// Exactly uniform sampling would have to pick classes in proportion to their size over the
+// ~5.5 * 10^9 classes, which needs the completion counts of every top band and is out of reach
+// for a generator; see the notes of `generateIndependent`.
+class GridGenerator {
+public:
+    static constexpr unsigned int DEFAULT_SEED_GRIDS = 256;
+    // The seed grids draw from `Random(seed, SEED_STREAM)`, apart from the streams of the chunks
+    static constexpr uint64_t SEED_STREAM = ~uint64_t(0);
+
+    // With 0 `seed_grids` every grid is filled independently
+    explicit GridGenerator(uint64_t seed, unsigned int seed_grids = DEFAULT_SEED_GRIDS);
+
+    // Falls back to `generateIndependent` when there are no seed grids
+    void generate(Random &random, PackedBoard *grids, size_t count) const;
+    // The seed grids are filled by the solver from randomly filled diagonal boxes, so classes
+    // are reached with the bias of that fill rather than in proportion to their size
+    void generateIndependent(Random &random, PackedBoard *grids, size_t count) const;
+
+    // Splits the work into chunks on `pool`, chunk `i` draws from `Random(seed, i)` so the
+    // output only depends on the seed
+    void generate(ThreadPool &pool,
+                  uint64_t seed,
+                  bool independent,
+                  PackedBoard *grids,
+                  size_t count) const;
+
+    static void randomTransform(Random &random, GridTransform &transform);
+    static void makeSeedGrid(const Cells &grid, SeedGrid &seed);
+
+private:
+    static constexpr size_t CHUNK_SIZE = 4096;
+
+    // Every grid is followed by its transposition
+    std::vector<SeedGrid> seeds;
+};
+
+#endif // GRID_GENERATOR_HPP
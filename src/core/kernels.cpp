@@ -0,0 +1,44 @@
+#include "kernels.hpp"
+
+#include <cstdlib>
+
+const BoardKernels &Kernels::get() { return current(); }
+
+bool Kernels::force(SimdLevel level) {
+    if (level > detectSimdLevel()) { return false; }
+
+    current() = select(level);
+    return true;
+}
+
+BoardKernels &Kernels::current() {
+    static BoardKernels kernels = [] {
+        SimdLevel level = detectSimdLevel();
+
+        SimdLevel requested;
+        const char *env = std::getenv("SUDOKU_SIMD");
+        if (env && parseSimdLevel(env, requested) && requested < level) { level = requested; }
+
+        return select(level);
+    }();
+
+    return kernels;
+}
+
+BoardKernels Kernels::select(SimdLevel level) {
+    switch (level) {
+        case SIMD_AVX512:
+            return {level, computeCandidatesAvx2, findConflictsAvx512, packCellsAvx2,
+                    unpackCellsAvx2, parseCellsAvx2, transformGridSse42};
+        case SIMD_AVX2:
+            return {level, computeCandidatesAvx2, findConflictsAvx2, packCellsAvx2,
+                    unpackCellsAvx2, parseCellsAvx2, transformGridSse42};
+        case SIMD_SSE42:
+            return {level, computeCandidatesSse42, findConflictsSse42, packCellsSse42,
+                    unpackCellsSse42, parseCellsSse42, transformGridSse42};
+        case SIMD_SCALAR: break;
+    }
+
+    return {SIMD_SCALAR, computeCandidatesScalar, findConflictsScalar, packCellsScalar,
+            unpackCellsScalar, parseCellsScalar, transformGridScalar};
+}
@@ -0,0 +1,39 @@
+#ifndef KERNELS_HPP
+#define KERNELS_HPP
+
+#include "board.hpp"
+#include "candidates.hpp"
+#include "cpu_features.hpp"
+#include "grid_generator.hpp"
+#include "packed_board.hpp"
+#include "puzzle_reader.hpp"
+#include "validation.hpp"
+
+struct BoardKernels {
+    SimdLevel level;
+    void (*computeCandidates)(const Cells &cells, Candidates &candidates);
+    void (*findConflicts)(const Cells &cells, UnitConflicts &conflicts);
+    void (*packCells)(const Cells &cells, PackedBoard &packed);
+    void (*unpackCells)(const PackedBoard &packed, Cells &cells);
+    bool (*parseCells)(const char *text, Cells &cells);
+    void (*transformGrid)(const SeedGrid &source, const GridTransform &transform, Cells &grid);
+};
+
+// Picks the board kernels once, on first use, for the best instruction set the CPU supports.
+// The `SUDOKU_SIMD` environment variable (scalar, sse4.2, avx2 or avx512) caps the level.
+class Kernels {
+public:
+    static const BoardKernels &get();
+
+    // Rebinds the kernels to a lower level, e.g. for benchmarks. Fails when the CPU does not
+    // support the requested level. Not thread-safe with respect to running kernels.
+    static bool force(SimdLevel level);
+
+private:
+    Kernels() { }
+
+    static BoardKernels &current();
+    static BoardKernels select(SimdLevel level);
+};
+
+#endif // KERNELS_HPP
@@ -0,0 +1,26 @@
+#include "latency.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+static uint64_t percentile(const std::vector<uint64_t> &sorted, double fraction) {
+    const size_t rank = std::ceil(fraction * sorted.size());
+    return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+LatencySummary summarizeLatencies(std::vector<uint64_t> &latencies) {
+    LatencySummary summary;
+    if (latencies.empty()) { return summary; }
+
+    std::sort(latencies.begin(), latencies.end());
+
+    summary.count = latencies.size();
+    summary.mean  = std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+    summary.p50   = percentile(latencies, 0.5);
+    summary.p90   = percentile(latencies, 0.9);
+    summary.p99   = percentile(latencies, 0.99);
+    summary.p999  = percentile(latencies, 0.999);
+    summary.max   = latencies.back();
+    return summary;
+}
@@ -0,0 +1,21 @@
+#ifndef LATENCY_HPP
+#define LATENCY_HPP
+
+#include <cstdint>
+#include <vector>
+
+// Distribution of per-puzzle latencies, all in nanoseconds
+struct LatencySummary {
+    uint64_t count = 0;
+    double mean    = 0;
+    uint64_t p50   = 0;
+    uint64_t p90   = 0;
+    uint64_t p99   = 0;
+    uint64_t p999  = 0;
+    uint64_t max   = 0;
+};
+
+// Nearest-rank percentiles, sorts `latencies` in place
+LatencySummary summarizeLatencies(std::vector<uint64_t> &latencies);
+
+#endif // LATENCY_HPP
@@ -0,0 +1,551 @@
+#include "logical_solver.hpp"
+
+#include <bit>
+#include <chrono>
+
+using Clock = std::chrono::steady_clock;
+
+// Position of a cell inside each of its units, the bit it takes in `places`
+static constexpr std::array<std::array<uint8_t, 3>, 9 * 9> CELL_POSITIONS = [] {
+    std::array<std::array<uint8_t, 3>, 9 * 9> result = {};
+    for (unsigned int cell = 0; cell < 9 * 9; cell++) {
+        for (unsigned int i = 0; i < 3; i++) {
+            const auto &unit_cells = UNIT_CELLS[CELL_UNITS[cell][i]];
+            for (unsigned int position = 0; position < 9; position++) {
+                if (unit_cells[position] == cell) { result[cell][i] = position; }
+            }
+        }
+    }
+    return result;
+}();
+
+// Bits set in every 9-bit mask, the baseline x86-64 target has no popcount instruction
+static constexpr std::array<uint8_t, 512> BIT_COUNTS = [] {
+    std::array<uint8_t, 512> result = {};
+    for (unsigned int mask = 0; mask < 512; mask++) { result[mask] = std::popcount(mask); }
+    return result;
+}();
+
+// Box positions in the same box row and box column
+static constexpr uint16_t BOX_ROW    = 0x007;
+static constexpr uint16_t BOX_COLUMN = 0x049;
+
+// Calls `check(subset)` for every subset of `items` with `size` bits until it returns true
+template <typename Check>
+static bool forEachSubset(uint16_t items, unsigned int size, Check check) {
+    if (BIT_COUNTS[items] < size) { return false; }
+
+    for (uint16_t subset = items; subset != 0; subset = (subset - 1) & items) {
+        if (BIT_COUNTS[subset] == size && check(subset)) { return true; }
+    }
+    return false;
+}
+
+const char *getTechniqueName(Technique technique) {
+    switch (technique) {
+        case TECHNIQUE_HIDDEN_SINGLE: return "hidden_single";
+        case TECHNIQUE_NAKED_SINGLE: return "naked_single";
+        case TECHNIQUE_LOCKED_CANDIDATES: return "locked_candidates";
+        case TECHNIQUE_NAKED_PAIR: return "naked_pair";
+        case TECHNIQUE_HIDDEN_PAIR: return "hidden_pair";
+        case TECHNIQUE_NAKED_TRIPLE: return "naked_triple";
+        case TECHNIQUE_HIDDEN_TRIPLE: return "hidden_triple";
+        case TECHNIQUE_X_WING: return "x_wing";
+        case TECHNIQUE_SIMPLE_COLORING: return "simple_coloring";
+        case TECHNIQUE_XY_WING: return "xy_wing";
+        case TECHNIQUE_SWORDFISH: return "swordfish";
+        default: return "unknown";
+    }
+}
+
+bool LogicalSolver::load(const Cells &puzzle) {
+    this->cells         = puzzle;
+    this->used          = {};
+    this->places        = {};
+    this->empty         = 0;
+    this->contradiction = false;
+    this->steps.clear();
+
+    for (unsigned int cell = 0; cell < 9 * 9; cell++) {
+        if (puzzle[cell] == 0) {
+            this->empty++;
+            continue;
+        }
+
+        if (puzzle[cell] > 9) {
+            this->contradiction = true;
+            continue;
+        }
+
+        const uint16_t bit = 1 << (puzzle[cell] - 1);
+        for (unsigned int unit : CELL_UNITS[cell]) {
+            if (this->used[unit] & bit) { this->contradiction = true; }
+            this->used[unit] |= bit;
+        }
+    }
+
+    computeCandidates(puzzle, this->candidates);
+    for (unsigned int cell = 0; cell < 9 * 9; cell++) {
+        const auto &units = CELL_UNITS[cell];
+        if (puzzle[cell] == 0 && this->candidates[cell] == 0) { this->contradiction = true; }
+
+        for (uint16_t digits = this->candidates[cell]; digits != 0; digits &= digits - 1) {
+            const unsigned int digit = std::countr_zero(digits);
+            for (unsigned int i = 0; i < 3; i++) {
+                this->places[digit][units[i]] |= 1 << CELL_POSITIONS[cell][i];
+            }
+        }
+    }
+
+    for (unsigned int unit = 0; unit < 3 * 9; unit++) {
+        for (unsigned int digit = 0; digit < 9; digit++) {
+            if (!(this->used[unit] & (1 << digit)) && this->places[digit][unit] == 0) {
+                this->contradiction = true;
+            }
+        }
+    }
+
+    return !this->contradiction;
+}
+
+bool LogicalSolver::step() {
+    if (this->empty == 0 || this->contradiction) { return false; }
+
+    for (unsigned int technique = 0; technique < TECHNIQUE_COUNT; technique++) {
+        LogicalStep step;
+        step.technique = Technique(technique);
+
+        const auto start   = Clock::now();
+        const bool applied = this->apply(step.technique, step);
+        const auto elapsed = Clock::now() - start;
+
+        TechniqueStats &stats = this->stats[technique];
+        stats.attempts++;
+        stats.nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        if (applied) {
+            stats.applications++;
+            this->steps.push_back(step);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool LogicalSolver::solve(const Cells &puzzle) {
+    if (!this->load(puzzle)) { return false; }
+
+    while (this->step()) { }
+    return this->isSolved();
+}
+
+bool LogicalSolver::isSolved() const { return this->empty == 0 && !this->contradiction; }
+
+bool LogicalSolver::isContradicted() const { return this->contradiction; }
+
+const Cells &LogicalSolver::getCells() const { return this->cells; }
+
+const Candidates &LogicalSolver::getCandidates() const { return this->candidates; }
+
+const std::vector<LogicalStep> &LogicalSolver::getSteps() const { return this->steps; }
+
+const std::array<TechniqueStats, TECHNIQUE_COUNT> &LogicalSolver::getStats() const {
+    return this->stats;
+}
+
+void LogicalSolver::resetStats() { this->stats = {}; }
+
+void LogicalSolver::place(unsigned int cell, unsigned int digit, LogicalStep &step) {
+    step.cell  = cell;
+    step.digit = digit + 1;
+
+    this->cells[cell] = digit + 1;
+    this->empty--;
+
+    const auto &units = CELL_UNITS[cell];
+    for (unsigned int unit : units) { this->used[unit] |= 1 << digit; }
+
+    // The cell no longer takes any digit
+    for (uint16_t digits = this->candidates[cell]; digits != 0; digits &= digits - 1) {
+        const unsigned int other = std::countr_zero(digits);
+        for (unsigned int i = 0; i < 3; i++) {
+            uint16_t &places = this->places[other][units[i]];
+            places &= ~(1 << CELL_POSITIONS[cell][i]);
+            if (places == 0 && !(this->used[units[i]] & (1 << other))) {
+                this->contradiction = true;
+            }
+        }
+    }
+    this->candidates[cell] = 0;
+
+    for (unsigned int peer : PEERS[cell]) {
+        if (this->candidates[peer] & (1 << digit)) { this->eliminate(peer, digit, step); }
+    }
+}
+
+void LogicalSolver::eliminate(unsigned int cell, unsigned int digit, LogicalStep &step) {
+    const uint16_t bit = 1 << digit;
+    if (!(this->candidates[cell] & bit)) { return; }
+
+    step.eliminations++;
+    this->candidates[cell] &= ~bit;
+    if (this->candidates[cell] == 0) { this->contradiction = true; }
+
+    const auto &units = CELL_UNITS[cell];
+    for (unsigned int i = 0; i < 3; i++) {
+        uint16_t &places = this->places[digit][units[i]];
+        places &= ~(1 << CELL_POSITIONS[cell][i]);
+        if (places == 0 && !(this->used[units[i]] & bit)) { this->contradiction = true; }
+    }
+}
+
+LogicalSolver::Set LogicalSolver::getDigitCells(unsigned int digit) const {
+    Set result;
+    for (unsigned int cell = 0; cell < 9 * 9; cell++) {
+        if (this->candidates[cell] & (1 << digit)) { result.set(cell); }
+    }
+    return result;
+}
+
+bool LogicalSolver::apply(Technique technique, LogicalStep &step) {
+    switch (technique) {
+        case TECHNIQUE_HIDDEN_SINGLE: return this->findHiddenSingle(step);
+        case TECHNIQUE_NAKED_SINGLE: return this->findNakedSingle(step);
+        case TECHNIQUE_LOCKED_CANDIDATES: return this->findLockedCandidates(step);
+        case TECHNIQUE_NAKED_PAIR: return this->findNakedPair(step);
+        case TECHNIQUE_HIDDEN_PAIR: return this->findHiddenPair(step);
+        case TECHNIQUE_NAKED_TRIPLE: return this->findNakedTriple(step);
+        case TECHNIQUE_HIDDEN_TRIPLE: return this->findHiddenTriple(step);
+        case TECHNIQUE_X_WING: return this->findXWing(step);
+        case TECHNIQUE_SIMPLE_COLORING: return this->findSimpleColoring(step);
+        case TECHNIQUE_XY_WING: return this->findXYWing(step);
+        case TECHNIQUE_SWORDFISH: return this->findSwordfish(step);
+        default: return false;
+    }
+}
+
+// A digit with a single place left in a unit. Boxes come first, they are the easiest to spot.
+bool LogicalSolver::findHiddenSingle(LogicalStep &step) {
+    for (unsigned int i = 0; i < 3 * 9; i++) {
+        const unsigned int unit = (i + 2 * 9) % (3 * 9);
+
+        // Digits seen once and more than once, a whole unit at a time
+        uint16_t once = 0, more = 0;
+        for (unsigned int cell : UNIT_CELLS[unit]) {
+            more |= once & this->candidates[cell];
+            once |= this->candidates[cell];
+        }
+
+        const uint16_t singles = once & ~more;
+        if (singles != 0) {
+            const unsigned int digit = std::countr_zero(singles);
+            this->place(UNIT_CELLS[unit][std::countr_zero(this->places[digit][unit])], digit, step);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// A cell with a single candidate left
+bool LogicalSolver::findNakedSingle(LogicalStep &step) {
+    for (unsigned int cell = 0; cell < 9 * 9; cell++) {
+        const uint16_t digits = this->candidates[cell];
+        if (digits != 0 && (digits & (digits - 1)) == 0) {
+            this->place(cell, std::countr_zero(digits), step);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Pointing: the places of a digit in a box share a row or column, so the rest of that line
+// loses the digit. Claiming: the places of a digit in a line share a box, so the rest of that
+// box loses it.
+bool LogicalSolver::findLockedCandidates(LogicalStep &step) {
+    for (unsigned int digit = 0; digit < 9; digit++) {
+        const auto &places = this->places[digit];
+
+        for (unsigned int box = 0; box < 9; box++) {
+            const uint16_t in_box = places[2 * 9 + box];
+            if (in_box == 0) { continue; }
+
+            for (unsigned int i = 0; i < 3; i++) {
+                if ((in_box & ~(BOX_ROW << (3 * i))) == 0) {
+                    const unsigned int row = (box / 3) * 3 + i;
+                    const uint16_t outside = places[row] & ~(BOX_ROW << (3 * (box % 3)));
+                    for (uint16_t p = outside; p != 0; p &= p - 1) {
+                        this->eliminate(row * 9 + std::countr_zero(p), digit, step);
+                    }
+                }
+
+                if ((in_box & ~(BOX_COLUMN << i)) == 0) {
+                    const unsigned int column = (box % 3) * 3 + i;
+                    const uint16_t outside    = places[9 + column] & ~(BOX_ROW << (3 * (box / 3)));
+                    for (uint16_t p = outside; p != 0; p &= p - 1) {
+                        this->eliminate(std::countr_zero(p) * 9 + column, digit, step);
+                    }
+                }
+            }
+
+            if (step.eliminations != 0) { return true; }
+        }
+
+        for (unsigned int line = 0; line < 9; line++) {
+            const uint16_t in_row    = places[line];
+            const uint16_t in_column = places[9 + line];
+
+            for (unsigned int i = 0; i < 3; i++) {
+                if (in_row != 0 && (in_row & ~(BOX_ROW << (3 * i))) == 0) {
+                    const unsigned int box = (line / 3) * 3 + i;
+                    const uint16_t outside = places[2 * 9 + box] & ~(BOX_ROW << (3 * (line % 3)));
+                    for (uint16_t p = outside; p != 0; p &= p - 1) {
+                        this->eliminate(UNIT_CELLS[2 * 9 + box][std::countr_zero(p)], digit, step);
+                    }
+                }
+
+                if (in_column != 0 && (in_column & ~(BOX_ROW << (3 * i))) == 0) {
+                    const unsigned int box = i * 3 + line / 3;
+                    const uint16_t outside = places[2 * 9 + box] & ~(BOX_COLUMN << (line % 3));
+                    for (uint16_t p = outside; p != 0; p &= p - 1) {
+                        this->eliminate(UNIT_CELLS[2 * 9 + box][std::countr_zero(p)], digit, step);
+                    }
+                }
+            }
+
+            if (step.eliminations != 0) { return true; }
+        }
+    }
+
+    return false;
+}
+
+bool LogicalSolver::findNakedPair(LogicalStep &step) { return this->findNakedSubset(2, step); }
+
+bool LogicalSolver::findHiddenPair(LogicalStep &step) { return this->findHiddenSubset(2, step); }
+
+bool LogicalSolver::findNakedTriple(LogicalStep &step) { return this->findNakedSubset(3, step); }
+
+bool LogicalSolver::findHiddenTriple(LogicalStep &step) {
+    return this->findHiddenSubset(3, step);
+}
+
+bool LogicalSolver::findXWing(LogicalStep &step) { return this->findFish(2, step); }
+
+bool LogicalSolver::findSwordfish(LogicalStep &step) { return this->findFish(3, step); }
+
+// Two cells of the same digit linked by a unit where the digit has only those two places
+// (a conjugate pair) take opposite values, so every chain of conjugate pairs splits into two
+// colors, one of which is true. A color that sees itself is false, and cells that see both
+// colors lose the digit.
+bool LogicalSolver::findSimpleColoring(LogicalStep &step) {
+    for (unsigned int digit = 0; digit < 9; digit++) {
+        const Set digit_cells = this->getDigitCells(digit);
+        Set visited;
+
+        for (unsigned int start = digit_cells.next(0); start < 9 * 9;
+             start = digit_cells.next(start + 1)) {
+            if (visited.test(start)) { continue; }
+
+            std::array<Set, 2> colors;
+            std::array<uint8_t, 9 * 9> stack;
+            unsigned int stack_size = 0;
+
+            colors[0].set(start);
+            visited.set(start);
+            stack[stack_size++] = start;
+            while (stack_size != 0) {
+                const unsigned int cell  = stack[--stack_size];
+                const unsigned int color = colors[1].test(cell);
+
+                for (unsigned int i = 0; i < 3; i++) {
+                    const unsigned int unit = CELL_UNITS[cell][i];
+                    const uint16_t places   = this->places[digit][unit];
+                    if (BIT_COUNTS[places] != 2) { continue; }
+
+                    const uint16_t other_place = places & ~(1 << CELL_POSITIONS[cell][i]);
+                    const unsigned int other   = UNIT_CELLS[unit][std::countr_zero(other_place)];
+                    if (visited.test(other)) { continue; }
+
+                    visited.set(other);
+                    colors[1 - color].set(other);
+                    stack[stack_size++] = other;
+                }
+            }
+
+            if (!colors[1].any()) { continue; }
+
+            std::array<Set, 2> seen;
+            for (unsigned int color = 0; color < 2; color++) {
+                for (unsigned int cell = colors[color].next(0); cell < 9 * 9;
+                     cell = colors[color].next(cell + 1)) {
+                    seen[color] |= Tables::PEER_MASKS[cell];
+                }
+            }
+
+            for (unsigned int color = 0; color < 2; color++) {
+                if ((seen[color] & colors[color]).any()) {
+                    for (unsigned int cell = colors[color].next(0); cell < 9 * 9;
+                         cell = colors[color].next(cell + 1)) {
+                        this->eliminate(cell, digit, step);
+                    }
+                    return true;
+                }
+            }
+
+            Set targets = seen[0] & seen[1] & digit_cells;
+            targets ^= targets & (colors[0] | colors[1]);
+            for (unsigned int cell = targets.next(0); cell < 9 * 9; cell = targets.next(cell + 1)) {
+                this->eliminate(cell, digit, step);
+            }
+
+            if (step.eliminations != 0) { return true; }
+        }
+    }
+
+    return false;
+}
+
+// A pivot with candidates xy sees a pincer with xz and a pincer with yz. Either pincer is z,
+// so cells that see both pincers lose z.
+bool LogicalSolver::findXYWing(LogicalStep &step) {
+    Set bivalue;
+    for (unsigned int cell = 0; cell < 9 * 9; cell++) {
+        if (BIT_COUNTS[this->candidates[cell]] == 2) { bivalue.set(cell); }
+    }
+
+    for (unsigned int pivot = bivalue.next(0); pivot < 9 * 9; pivot = bivalue.next(pivot + 1)) {
+        const uint16_t xy = this->candidates[pivot];
+        const Set pincers = Tables::PEER_MASKS[pivot] & bivalue;
+
+        for (unsigned int a = pincers.next(0); a < 9 * 9; a = pincers.next(a + 1)) {
+            const uint16_t xz = this->candidates[a];
+            if (BIT_COUNTS[xz & xy] != 1) { continue; }
+
+            const uint16_t z  = xz & ~xy;
+            const uint16_t yz = (xy & ~xz) | z;
+            for (unsigned int b = pincers.next(a + 1); b < 9 * 9; b = pincers.next(b + 1)) {
+                if (this->candidates[b] != yz) { continue; }
+
+                const unsigned int digit = std::countr_zero(z);
+                const Set targets =
+                    Tables::PEER_MASKS[a] & Tables::PEER_MASKS[b] & this->getDigitCells(digit);
+                for (unsigned int cell = targets.next(0); cell < 9 * 9;
+                     cell = targets.next(cell + 1)) {
+                    this->eliminate(cell, digit, step);
+                }
+
+                if (step.eliminations != 0) { return true; }
+            }
+        }
+    }
+
+    return false;
+}
+
+// `size` cells of a unit with only `size` candidates between them take all of those digits, so
+// the other cells of the unit lose them
+bool LogicalSolver::findNakedSubset(unsigned int size, LogicalStep &step) {
+    for (unsigned int unit = 0; unit < 3 * 9; unit++) {
+        const auto &unit_cells = UNIT_CELLS[unit];
+
+        uint16_t open = 0, small = 0;
+        for (unsigned int i = 0; i < 9; i++) {
+            const unsigned int count = BIT_COUNTS[this->candidates[unit_cells[i]]];
+            if (count != 0) { open |= 1 << i; }
+            if (count >= 2 && count <= size) { small |= 1 << i; }
+        }
+
+        const bool found = forEachSubset(small, size, [&](uint16_t subset) {
+            uint16_t digits = 0;
+            for (uint16_t p = subset; p != 0; p &= p - 1) {
+                digits |= this->candidates[unit_cells[std::countr_zero(p)]];
+            }
+            if (BIT_COUNTS[digits] != size) { return false; }
+
+            for (uint16_t p = open & ~subset; p != 0; p &= p - 1) {
+                const unsigned int cell = unit_cells[std::countr_zero(p)];
+                for (uint16_t d = this->candidates[cell] & digits; d != 0; d &= d - 1) {
+                    this->eliminate(cell, std::countr_zero(d), step);
+                }
+            }
+            return step.eliminations != 0;
+        });
+
+        if (found) { return true; }
+    }
+
+    return false;
+}
+
+// `size` digits of a unit with only `size` places between them take all of those cells, so
+// the cells lose every other candidate
+bool LogicalSolver::findHiddenSubset(unsigned int size, LogicalStep &step) {
+    for (unsigned int unit = 0; unit < 3 * 9; unit++) {
+        uint16_t small = 0;
+        for (unsigned int digit = 0; digit < 9; digit++) {
+            const unsigned int count = BIT_COUNTS[this->places[digit][unit]];
+            if (count >= 2 && count <= size) { small |= 1 << digit; }
+        }
+
+        const bool found = forEachSubset(small, size, [&](uint16_t digits) {
+            uint16_t positions = 0;
+            for (uint16_t d = digits; d != 0; d &= d - 1) {
+                positions |= this->places[std::countr_zero(d)][unit];
+            }
+            if (BIT_COUNTS[positions] != size) { return false; }
+
+            for (uint16_t p = positions; p != 0; p &= p - 1) {
+                const unsigned int cell = UNIT_CELLS[unit][std::countr_zero(p)];
+                for (uint16_t d = this->candidates[cell] & ~digits; d != 0; d &= d - 1) {
+                    this->eliminate(cell, std::countr_zero(d), step);
+                }
+            }
+            return step.eliminations != 0;
+        });
+
+        if (found) { return true; }
+    }
+
+    return false;
+}
+
+// `size` rows whose places of a digit fall into `size` columns: the digit takes one cell of
+// each of those columns within the rows, so the rest of the columns lose it. The same holds
+// with rows and columns swapped.
+bool LogicalSolver::findFish(unsigned int size, LogicalStep &step) {
+    for (unsigned int digit = 0; digit < 9; digit++) {
+        const auto &places = this->places[digit];
+
+        for (unsigned int base = 0; base < 2 * 9; base += 9) {
+            const unsigned int cover = 9 - base;
+
+            uint16_t lines = 0;
+            for (unsigned int line = 0; line < 9; line++) {
+                const unsigned int count = BIT_COUNTS[places[base + line]];
+                if (count >= 2 && count <= size) { lines |= 1 << line; }
+            }
+
+            const bool found = forEachSubset(lines, size, [&](uint16_t subset) {
+                uint16_t covered = 0;
+                for (uint16_t l = subset; l != 0; l &= l - 1) {
+                    covered |= places[base + std::countr_zero(l)];
+                }
+                if (BIT_COUNTS[covered] != size) { return false; }
+
+                for (uint16_t c = covered; c != 0; c &= c - 1) {
+                    const unsigned int unit = cover + std::countr_zero(c);
+                    for (uint16_t p = places[unit] & ~subset; p != 0; p &= p - 1) {
+                        this->eliminate(UNIT_CELLS[unit][std::countr_zero(p)], digit, step);
+                    }
+                }
+                return step.eliminations != 0;
+            });
+
+            if (found) { return true; }
+        }
+    }
+
+    return false;
+}
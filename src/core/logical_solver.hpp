@@ -0,0 +1,113 @@
+#ifndef LOGICAL_SOLVER_HPP
+#define LOGICAL_SOLVER_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "board.hpp"
+#include "candidates.hpp"
+#include "tables.hpp"
+
+// Human solving techniques, from the easiest to the hardest. The solver always applies the
+// easiest one that makes progress.
+enum Technique {
+    TECHNIQUE_HIDDEN_SINGLE,
+    TECHNIQUE_NAKED_SINGLE,
+    TECHNIQUE_LOCKED_CANDIDATES,
+    TECHNIQUE_NAKED_PAIR,
+    TECHNIQUE_HIDDEN_PAIR,
+    TECHNIQUE_NAKED_TRIPLE,
+    TECHNIQUE_HIDDEN_TRIPLE,
+    TECHNIQUE_X_WING,
+    TECHNIQUE_SIMPLE_COLORING,
+    TECHNIQUE_XY_WING,
+    TECHNIQUE_SWORDFISH,
+    TECHNIQUE_COUNT,
+};
+
+const char *getTechniqueName(Technique technique);
+
+// One application of a technique: a placed digit, together with the candidates it removed from
+// its peers, or only removed candidates
+struct LogicalStep {
+    static constexpr unsigned int NO_CELL = 9 * 9;
+
+    Technique technique;
+    unsigned int cell         = NO_CELL;
+    unsigned int digit        = 0;
+    unsigned int eliminations = 0;
+};
+
+// Time spent in a technique, including the attempts that found nothing
+struct TechniqueStats {
+    uint64_t attempts     = 0;
+    uint64_t applications = 0;
+    uint64_t nanoseconds  = 0;
+};
+
+// Solves step by step like a person would, never guessing. Every cell keeps a candidate mask
+// and every unit keeps, per digit, the mask of positions the digit can still take, so hidden
+// subsets, fish and locked candidates are bit operations on whole units. Statistics add up
+// over all puzzles until `resetStats`.
+class LogicalSolver {
+public:
+    // Returns false when the givens already contradict each other
+    bool load(const Cells &puzzle);
+    // Applies the easiest technique that makes progress. Returns false when the puzzle is
+    // solved, stuck or found to be invalid.
+    bool step();
+    // Loads `puzzle` and steps until there is nothing left to do, returns whether it got solved
+    bool solve(const Cells &puzzle);
+
+    bool isSolved() const;
+    // An elimination left a cell or a digit of a unit without any place
+    bool isContradicted() const;
+
+    const Cells &getCells() const;
+    const Candidates &getCandidates() const;
+    // Steps since the last `load`
+    const std::vector<LogicalStep> &getSteps() const;
+
+    const std::array<TechniqueStats, TECHNIQUE_COUNT> &getStats() const;
+    void resetStats();
+
+private:
+    using Tables = BoardTables<3, 3>;
+    using Set    = Tables::Set;
+
+    Cells cells;
+    Candidates candidates;
+    // Digits placed in every unit
+    std::array<uint16_t, 3 * 9> used;
+    // `places[digit][unit]` has bit `i` set when `digit` can go to `UNIT_CELLS[unit][i]`
+    std::array<std::array<uint16_t, 3 * 9>, 9> places;
+    unsigned int empty;
+    bool contradiction;
+
+    std::vector<LogicalStep> steps;
+    std::array<TechniqueStats, TECHNIQUE_COUNT> stats;
+
+    void place(unsigned int cell, unsigned int digit, LogicalStep &step);
+    void eliminate(unsigned int cell, unsigned int digit, LogicalStep &step);
+    Set getDigitCells(unsigned int digit) const;
+    bool apply(Technique technique, LogicalStep &step);
+
+    bool findHiddenSingle(LogicalStep &step);
+    bool findNakedSingle(LogicalStep &step);
+    bool findLockedCandidates(LogicalStep &step);
+    bool findNakedPair(LogicalStep &step);
+    bool findHiddenPair(LogicalStep &step);
+    bool findNakedTriple(LogicalStep &step);
+    bool findHiddenTriple(LogicalStep &step);
+    bool findXWing(LogicalStep &step);
+    bool findSimpleColoring(LogicalStep &step);
+    bool findXYWing(LogicalStep &step);
+    bool findSwordfish(LogicalStep &step);
+
+    bool findNakedSubset(unsigned int size, LogicalStep &step);
+    bool findHiddenSubset(unsigned int size, LogicalStep &step);
+    bool findFish(unsigned int size, LogicalStep &step);
+};
+
+#endif // LOGICAL_SOLVER_HPP
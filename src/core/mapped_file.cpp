@@ -0,0 +1,100 @@
+#include "mapped_file.hpp"
+
+#include <iostream>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() { this->close(); }
+
+#ifdef _WIN32
+
+bool MappedFile::open(const char *path) {
+    this->close();
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER size;
+    if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &size)) {
+        std::cerr << "Failed to open file '" << path << "'" << std::endl;
+        if (file != INVALID_HANDLE_VALUE) { CloseHandle(file); }
+        return false;
+    }
+
+    this->file = file;
+    this->size = size.QuadPart;
+    if (this->size == 0) { return true; }
+
+    this->mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (this->mapping) {
+        this->data = (const char *)MapViewOfFile(this->mapping, FILE_MAP_READ, 0, 0, 0);
+    }
+    if (!this->data) {
+        std::cerr << "Failed to map file '" << path << "'" << std::endl;
+        this->close();
+        return false;
+    }
+
+    return true;
+}
+
+void MappedFile::close() {
+    if (this->data) { UnmapViewOfFile(this->data); }
+    if (this->mapping) { CloseHandle(this->mapping); }
+    if (this->file) { CloseHandle(this->file); }
+
+    this->data    = nullptr;
+    this->size    = 0;
+    this->mapping = nullptr;
+    this->file    = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const char *path) {
+    this->close();
+
+    const int fd = ::open(path, O_RDONLY);
+    struct stat status;
+    if (fd < 0 || fstat(fd, &status) != 0) {
+        std::cerr << "Failed to open file '" << path << "'" << std::endl;
+        if (fd >= 0) { ::close(fd); }
+        return false;
+    }
+
+    // The mapping keeps the file alive on its own
+    this->size = status.st_size;
+    if (this->size > 0) {
+        void *data = mmap(nullptr, this->size, PROT_READ, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            std::cerr << "Failed to map file '" << path << "'" << std::endl;
+            ::close(fd);
+            this->size = 0;
+            return false;
+        }
+
+        this->data = (const char *)data;
+    }
+
+    ::close(fd);
+    return true;
+}
+
+void MappedFile::close() {
+    if (this->data) { munmap((void *)this->data, this->size); }
+
+    this->data = nullptr;
+    this->size = 0;
+}
+
+#endif
+
+const char *MappedFile::getData() const { return this->data; }
+
+size_t MappedFile::getSize() const { return this->size; }
@@ -0,0 +1,30 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+
+// Read-only memory mapping of a whole file
+class MappedFile {
+public:
+    MappedFile() { }
+    ~MappedFile();
+
+    MappedFile(const MappedFile &)            = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool open(const char *path);
+    void close();
+
+    const char *getData() const;
+    size_t getSize() const;
+
+private:
+    const char *data = nullptr;
+    size_t size      = 0;
+#ifdef _WIN32
+    void *file    = nullptr;
+    void *mapping = nullptr;
+#endif
+};
+
+#endif // MAPPED_FILE_HPP
@@ -0,0 +1,60 @@
+#include "output_file.hpp"
+
+#include <cstring>
+#include <iostream>
+
+OutputFile::~OutputFile() { this->close(); }
+
+bool OutputFile::open(const char *path, const char *what) {
+    this->close();
+
+    this->path   = path;
+    this->what   = what;
+    this->failed = false;
+    this->file   = std::strcmp(path, "-") == 0 ? stdout : std::fopen(path, "wb");
+    if (!this->file) {
+        std::cerr << "Failed to write " << what << " to '" << path << "'" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool OutputFile::write(const std::string &buffer) {
+    if (!this->file || this->failed) { return false; }
+
+    if (std::fwrite(buffer.data(), 1, buffer.size(), this->file) != buffer.size()) {
+        std::cerr << "Failed to write " << this->what << " to '" << this->path << "'" << std::endl;
+        this->failed = true;
+        return false;
+    }
+
+    return true;
+}
+
+bool OutputFile::close() {
+    if (!this->file) { return !this->failed; }
+
+    // Buffered data can still fail to reach the disk
+    const bool flushed = this->file == stdout ? std::fflush(stdout) == 0
+                                              : std::fclose(this->file) == 0;
+    if (!flushed && !this->failed) {
+        std::cerr << "Failed to write " << this->what << " to '" << this->path << "'" << std::endl;
+        this->failed = true;
+    }
+
+    this->file = nullptr;
+    return !this->failed;
+}
+
+bool writeOutput(const char *path, const std::string &buffer, const char *what) {
+    OutputFile output;
+    return output.open(path, what) && output.write(buffer) && output.close();
+}
+
+void appendCells(const PackedBoard &packed, std::string &buffer) {
+    Cells cells;
+    unpackCells(packed, cells);
+    for (uint8_t digit : cells) { buffer.push_back('0' + digit); }
+    buffer.push_back('\n');
+}
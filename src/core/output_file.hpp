@@ -0,0 +1,37 @@
+#ifndef OUTPUT_FILE_HPP
+#define OUTPUT_FILE_HPP
+
+#include <cstdio>
+#include <string>
+
+#include "packed_board.hpp"
+
+// Output of the headless commands, written in large buffers. `-` is standard output. Failures
+// are reported once with the path and `what` is being written.
+class OutputFile {
+public:
+    OutputFile() { }
+    ~OutputFile();
+
+    OutputFile(const OutputFile &)            = delete;
+    OutputFile &operator=(const OutputFile &) = delete;
+
+    bool open(const char *path, const char *what);
+    bool write(const std::string &buffer);
+    // Returns false when any write failed
+    bool close();
+
+private:
+    std::FILE *file  = nullptr;
+    const char *path = "";
+    const char *what = "";
+    bool failed      = false;
+};
+
+// Writes all of `buffer` to `path` at once
+bool writeOutput(const char *path, const std::string &buffer, const char *what);
+
+// Appends the 81 digits of `packed` and a newline, the format `PuzzleReader` reads
+void appendCells(const PackedBoard &packed, std::string &buffer);
+
+#endif // OUTPUT_FILE_HPP
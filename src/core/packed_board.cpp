@@ -0,0 +1,133 @@
+#include "packed_board.hpp"
+
+#include <cstring>
+
+#include <immintrin.h>
+
+#include "cpu_features.hpp"
+#include "kernels.hpp"
+
+void packCells(const Cells &cells, PackedBoard &packed) {
+    Kernels::get().packCells(cells, packed);
+}
+
+void unpackCells(const PackedBoard &packed, Cells &cells) {
+    Kernels::get().unpackCells(packed, cells);
+}
+
+void packCellsScalar(const Cells &cells, PackedBoard &packed) {
+    packed = {};
+    for (unsigned int i = 0; i < 9 * 9; i++) {
+        packed.digits[i / 2] |= (cells[i] & 0x0F) << (i % 2 * 4);
+        if (cells[i] != 0) { packed.fixed[i / 8] |= 1 << (i % 8); }
+    }
+}
+
+void unpackCellsScalar(const PackedBoard &packed, Cells &cells) {
+    for (unsigned int i = 0; i < 9 * 9; i++) {
+        cells[i] = (packed.digits[i / 2] >> (i % 2 * 4)) & 0x0F;
+    }
+}
+
+// The 81st cell does not fill a whole vector, both vector kernels finish with it
+static inline void packLastCell(const Cells &cells, PackedBoard &packed) {
+    packed.digits[40] = cells[80] & 0x0F;
+    packed.fixed[10]  = cells[80] != 0;
+}
+
+// Packs cells `16 * chunk` to `16 * chunk + 15` into 8 digit bytes and 2 fixed bytes
+TARGET_SSE42 static inline void packChunk(const Cells &cells,
+                                          PackedBoard &packed,
+                                          unsigned int chunk) {
+    const __m128i v = _mm_loadu_si128((const __m128i *)&cells[chunk * 16]);
+
+    // Every pair of bytes becomes `even + 16 * odd`. Like the scalar packer only the low nibble
+    // of a cell is kept, larger values would saturate into the neighbouring cell.
+    const __m128i nibbles = _mm_and_si128(v, _mm_set1_epi8(0x0F));
+    const __m128i pairs   = _mm_maddubs_epi16(nibbles, _mm_set1_epi16(0x1001));
+    const __m128i digits  = _mm_packus_epi16(pairs, pairs);
+    _mm_storel_epi64((__m128i *)&packed.digits[chunk * 8], digits);
+
+    const uint16_t fixed = ~_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128()));
+    std::memcpy(&packed.fixed[chunk * 2], &fixed, sizeof(fixed));
+}
+
+TARGET_SSE42 static inline void unpackChunk(const PackedBoard &packed,
+                                            Cells &cells,
+                                            unsigned int chunk) {
+    const __m128i digits = _mm_loadl_epi64((const __m128i *)&packed.digits[chunk * 8]);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i low    = _mm_and_si128(digits, nibble);
+    const __m128i high   = _mm_and_si128(_mm_srli_epi16(digits, 4), nibble);
+    _mm_storeu_si128((__m128i *)&cells[chunk * 16], _mm_unpacklo_epi8(low, high));
+}
+
+TARGET_SSE42 void packCellsSse42(const Cells &cells, PackedBoard &packed) {
+    for (unsigned int chunk = 0; chunk < 5; chunk++) { packChunk(cells, packed, chunk); }
+    packLastCell(cells, packed);
+}
+
+TARGET_SSE42 void unpackCellsSse42(const PackedBoard &packed, Cells &cells) {
+    for (unsigned int chunk = 0; chunk < 5; chunk++) { unpackChunk(packed, cells, chunk); }
+    cells[80] = packed.digits[40] & 0x0F;
+}
+
+TARGET_AVX2 void packCellsAvx2(const Cells &cells, PackedBoard &packed) {
+    const __m256i weights = _mm256_set1_epi16(0x1001);
+    for (unsigned int half = 0; half < 2; half++) {
+        const __m256i v = _mm256_loadu_si256((const __m256i *)&cells[half * 32]);
+
+        // Packing works per 128-bit lane, the permute joins the two 8 byte results
+        const __m256i nibbles = _mm256_and_si256(v, _mm256_set1_epi8(0x0F));
+        const __m256i pairs   = _mm256_maddubs_epi16(nibbles, weights);
+        const __m256i digits  = _mm256_permute4x64_epi64(_mm256_packus_epi16(pairs, pairs), 0x08);
+        _mm_storeu_si128((__m128i *)&packed.digits[half * 16], _mm256_castsi256_si128(digits));
+
+        const uint32_t fixed = ~_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_setzero_si256()));
+        std::memcpy(&packed.fixed[half * 4], &fixed, sizeof(fixed));
+    }
+
+    packChunk(cells, packed, 4);
+    packLastCell(cells, packed);
+}
+
+TARGET_AVX2 void unpackCellsAvx2(const PackedBoard &packed, Cells &cells) {
+    for (unsigned int half = 0; half < 2; half++) {
+        const __m128i digits = _mm_loadu_si128((const __m128i *)&packed.digits[half * 16]);
+
+        // Every byte gets its own 16-bit lane, then the high nibble moves to the upper byte
+        const __m256i wide    = _mm256_cvtepu8_epi16(digits);
+        const __m256i shifted = _mm256_slli_epi16(wide, 4);
+        const __m256i low     = _mm256_and_si256(wide, _mm256_set1_epi16(0x000F));
+        const __m256i high    = _mm256_and_si256(shifted, _mm256_set1_epi16(0x0F00));
+        _mm256_storeu_si256((__m256i *)&cells[half * 32], _mm256_or_si256(low, high));
+    }
+
+    unpackChunk(packed, cells, 4);
+    cells[80] = packed.digits[40] & 0x0F;
+}
+
+PackedBoard packBoard(const Board<3, 3> &board) {
+    PackedBoard packed;
+    packCells(board.getCells(), packed);
+
+    packed.fixed = {};
+    for (unsigned int i = 0; i < 9 * 9; i++) {
+        if (board.get(i).type == NUMBER_FIXED) { packed.fixed[i / 8] |= 1 << (i % 8); }
+    }
+
+    return packed;
+}
+
+void unpackBoard(const PackedBoard &packed, Board<3, 3> &board) {
+    Cells cells, puzzle;
+    unpackCells(packed, cells);
+    for (unsigned int i = 0; i < 9 * 9; i++) {
+        puzzle[i] = (packed.fixed[i / 8] >> (i % 8)) & 1 ? cells[i] : 0;
+    }
+
+    board.load(puzzle);
+    for (unsigned int i = 0; i < 9 * 9; i++) {
+        if (puzzle[i] == 0) { board.set(i, cells[i]); }
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef PACKED_BOARD_HPP
+#define PACKED_BOARD_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "board.hpp"
+
+// 9x9 board stored with 4 bits per digit plus one bit per fixed cell, 52 bytes instead of the
+// 81 of `Cells` or the 648 of the `Number`s of a `Board`. Used wherever many boards are kept
+// or moved around.
+struct PackedBoard {
+    // Cell `2 * i` in the low nibble of byte `i` and cell `2 * i + 1` in the high nibble
+    std::array<uint8_t, 41> digits;
+    // Bit `i % 8` of byte `i / 8` is set when cell `i` is fixed
+    std::array<uint8_t, 11> fixed;
+
+    bool operator==(const PackedBoard &other) const = default;
+};
+
+static_assert(sizeof(PackedBoard) == 52);
+
+// Packs `cells` as a puzzle: every non-zero cell is marked fixed. Only the low 4 bits of a cell
+// are stored, every kernel gives the same bytes for any input. Uses the kernel selected by
+// `Kernels`.
+void packCells(const Cells &cells, PackedBoard &packed);
+void unpackCells(const PackedBoard &packed, Cells &cells);
+
+void packCellsScalar(const Cells &cells, PackedBoard &packed);
+void packCellsSse42(const Cells &cells, PackedBoard &packed);
+void packCellsAvx2(const Cells &cells, PackedBoard &packed);
+void unpackCellsScalar(const PackedBoard &packed, Cells &cells);
+void unpackCellsSse42(const PackedBoard &packed, Cells &cells);
+void unpackCellsAvx2(const PackedBoard &packed, Cells &cells);
+
+// Keeps the fixed and changable numbers of a game apart
+PackedBoard packBoard(const Board<3, 3> &board);
+void unpackBoard(const PackedBoard &packed, Board<3, 3> &board);
+
+#endif // PACKED_BOARD_HPP
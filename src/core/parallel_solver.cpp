@@ -0,0 +1,90 @@
+#include "parallel_solver.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+ParallelSolver::ParallelSolver(ThreadPool &pool, unsigned int max_split_depth)
+    : pool(pool), max_split_depth(max_split_depth) { }
+
+bool ParallelSolver::solve(const Cells &puzzle) { return this->countSolutions(puzzle, 1) == 1; }
+
+unsigned int ParallelSolver::countSolutions(const Cells &puzzle, unsigned int limit) {
+    this->stats = {};
+    if (limit == 0) { return 0; }
+
+    std::vector<Cells> subtrees;
+    unsigned int split_found = 0;
+    this->split(puzzle, limit, subtrees, split_found);
+    if (split_found >= limit || subtrees.empty()) { return std::min(split_found, limit); }
+
+    std::atomic<bool> stop          = false;
+    std::atomic<unsigned int> found = split_found;
+    std::atomic<uint64_t> nodes = 0, backtracks = 0;
+    std::mutex solution_mutex;
+    bool has_solution = split_found > 0;
+
+    this->pool.parallelFor(subtrees.size(), 1, [&](size_t begin, size_t end) {
+        Solver<3, 3> solver;
+        solver.setStopFlag(&stop);
+
+        for (size_t i = begin; i < end && !stop; i++) {
+            const unsigned int count = solver.countSolutions(subtrees[i], limit);
+            nodes += solver.getStats().nodes;
+            backtracks += solver.getStats().backtracks;
+            if (count == 0) { continue; }
+
+            {
+                std::lock_guard<std::mutex> lock(solution_mutex);
+                if (!has_solution) {
+                    this->solution = solver.getSolution();
+                    has_solution   = true;
+                }
+            }
+
+            if ((found += count) >= limit) { stop = true; }
+        }
+    });
+
+    this->stats.nodes += nodes;
+    this->stats.backtracks += backtracks;
+    return std::min(found.load(), limit);
+}
+
+const Cells &ParallelSolver::getSolution() const { return this->solution; }
+
+const SolverStats &ParallelSolver::getStats() const { return this->stats; }
+
+void ParallelSolver::split(const Cells &puzzle,
+                           unsigned int limit,
+                           std::vector<Cells> &subtrees,
+                           unsigned int &found) {
+    // A few subtrees per thread keep the workers busy when some of them finish early
+    const size_t target = this->pool.getThreadCount() * 8;
+
+    Solver<3, 3> solver;
+    std::vector<Cells> frontier = {puzzle}, next, children;
+    for (unsigned int depth = 0; depth < this->max_split_depth && frontier.size() < target;
+         depth++) {
+        next.clear();
+
+        for (const Cells &cells : frontier) {
+            const bool valid = solver.branch(cells, children);
+            this->stats.nodes++;
+
+            if (!valid) {
+                this->stats.backtracks++;
+            } else if (children.empty()) {
+                if (found++ == 0) { this->solution = solver.getSolution(); }
+                if (found >= limit) { return; }
+            } else {
+                next.insert(next.end(), children.begin(), children.end());
+            }
+        }
+
+        std::swap(frontier, next);
+        if (frontier.empty()) { break; }
+    }
+
+    subtrees = std::move(frontier);
+}
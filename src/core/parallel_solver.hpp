@@ -0,0 +1,37 @@
+#ifndef PARALLEL_SOLVER_HPP
+#define PARALLEL_SOLVER_HPP
+
+#include <vector>
+
+#include "board.hpp"
+#include "solver.hpp"
+#include "thread_pool.hpp"
+
+// Solves a single hard puzzle on many cores. The search tree is expanded breadth first at the
+// first branching cells until there are enough subtrees for the pool, then each subtree is
+// searched by its own `Solver`. All of them stop once the requested number of solutions is
+// found, e.g. the second one for a uniqueness check.
+class ParallelSolver {
+public:
+    explicit ParallelSolver(ThreadPool &pool, unsigned int max_split_depth = 6);
+
+    bool solve(const Cells &puzzle);
+    unsigned int countSolutions(const Cells &puzzle, unsigned int limit);
+
+    const Cells &getSolution() const;
+    const SolverStats &getStats() const;
+
+private:
+    ThreadPool &pool;
+    unsigned int max_split_depth;
+
+    Cells solution = {};
+    SolverStats stats;
+
+    void split(const Cells &puzzle,
+               unsigned int limit,
+               std::vector<Cells> &subtrees,
+               unsigned int &found);
+};
+
+#endif // PARALLEL_SOLVER_HPP
@@ -0,0 +1,187 @@
+#include "pattern_generator.hpp"
+
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <numeric>
+
+using Tables = BoardTables<3, 3>;
+
+const char *getSymmetryName(Symmetry symmetry) {
+    switch (symmetry) {
+        case SYMMETRY_NONE: return "none";
+        case SYMMETRY_ROTATIONAL: return "rotational";
+        case SYMMETRY_MIRROR: return "mirror";
+        case SYMMETRY_DIAGONAL: return "diagonal";
+        default: return "unknown";
+    }
+}
+
+Symmetry parseSymmetry(const char *name) {
+    for (unsigned int i = 0; i < SYMMETRY_COUNT; i++) {
+        if (std::strcmp(name, getSymmetryName(Symmetry(i))) == 0) { return Symmetry(i); }
+    }
+
+    return SYMMETRY_COUNT;
+}
+
+static unsigned int getImage(Symmetry symmetry, unsigned int cell) {
+    const unsigned int row = cell / 9, column = cell % 9;
+    switch (symmetry) {
+        case SYMMETRY_ROTATIONAL: return 9 * 9 - 1 - cell;
+        case SYMMETRY_MIRROR: return row * 9 + 8 - column;
+        case SYMMETRY_DIAGONAL: return column * 9 + row;
+        default: return cell;
+    }
+}
+
+ClueMask makeClueMask(Random &random, unsigned int clues, Symmetry symmetry) {
+    std::array<uint8_t, 9 * 9> order;
+    std::iota(order.begin(), order.end(), 0);
+    random.shuffle(order.data(), order.size());
+
+    unsigned int axis_cells = 0;
+    for (unsigned int cell = 0; cell < 9 * 9; cell++) {
+        axis_cells += getImage(symmetry, cell) == cell;
+    }
+
+    // Takes cells together with their image while they fit. Cells on the axis are their own
+    // image, one is only taken for an even remainder when another one can still fix the parity.
+    ClueMask mask;
+    unsigned int count = 0;
+    for (unsigned int cell : order) {
+        const unsigned int image = getImage(symmetry, cell);
+        const unsigned int size  = image == cell ? 1 : 2;
+        axis_cells -= size == 1;
+        if (mask.test(cell) || count + size > clues) { continue; }
+        if (size == 1 && (clues - count) % 2 == 0 && axis_cells == 0) { continue; }
+
+        mask.set(cell);
+        mask.set(image);
+        count += size;
+    }
+
+    return mask;
+}
+
+ClueMask getClueMask(const Cells &cells) {
+    ClueMask mask;
+    for (unsigned int i = 0; i < 9 * 9; i++) {
+        if (cells[i] != 0) { mask.set(i); }
+    }
+
+    return mask;
+}
+
+PatternGenerator::PatternGenerator(unsigned int threads): pool(threads) { }
+
+size_t PatternGenerator::generate(const ClueMask &mask,
+                                  size_t count,
+                                  uint64_t seed,
+                                  std::vector<PackedBoard> &puzzles) {
+    std::vector<PackedBoard> found(count);
+    std::vector<uint8_t> success(count);
+    if (mask.count() < MIN_PATTERN_CLUES) { count = 0; }
+
+    // The starting grids come from `GridGenerator::SEED_STREAM`, apart from every puzzle's stream
+    const GridGenerator grids(seed);
+    std::atomic<uint64_t> fillings = 0;
+    std::atomic<uint64_t> moves    = 0;
+    std::atomic<uint64_t> rejected = 0;
+    this->pool.parallelFor(count, 1, [&](size_t begin, size_t end) {
+        Solver<3, 3> solver;
+        PatternStats stats;
+        Cells puzzle;
+
+        for (size_t i = begin; i < end; i++) {
+            Random random(seed, i);
+            success[i] = generateOne(random, mask, grids, solver, puzzle, stats);
+            packCells(puzzle, found[i]);
+        }
+
+        fillings += stats.fillings;
+        moves += stats.moves;
+        rejected += stats.rejected;
+    });
+
+    this->stats.fillings += fillings;
+    this->stats.moves += moves;
+    this->stats.rejected += rejected;
+
+    puzzles.clear();
+    for (size_t i = 0; i < count; i++) {
+        if (success[i]) { puzzles.push_back(found[i]); }
+    }
+
+    return puzzles.size();
+}
+
+const PatternStats &PatternGenerator::getStats() const { return this->stats; }
+
+void PatternGenerator::resetStats() { this->stats = {}; }
+
+ThreadPool &PatternGenerator::getPool() { return this->pool; }
+
+bool PatternGenerator::generateOne(Random &random,
+                                   const ClueMask &mask,
+                                   const GridGenerator &grids,
+                                   Solver<3, 3> &solver,
+                                   Cells &puzzle,
+                                   PatternStats &stats) {
+    std::vector<uint8_t> clue_cells;
+    for (unsigned int cell = mask.next(0); cell < 9 * 9; cell = mask.next(cell + 1)) {
+        clue_cells.push_back(cell);
+    }
+
+    Cells grid;
+    PackedBoard packed;
+    for (unsigned int filling = 0; filling < MAX_FILLINGS; filling++) {
+        grids.generate(random, &packed, 1);
+        unpackCells(packed, grid);
+        stats.fillings++;
+
+        std::array<uint16_t, 3 * 9> used = {};
+        for (unsigned int i = 0; i < 9 * 9; i++) {
+            puzzle[i] = mask.test(i) ? grid[i] : 0;
+            if (puzzle[i] == 0) { continue; }
+
+            for (unsigned int unit : Tables::CELL_UNITS[i]) { used[unit] |= 1 << (puzzle[i] - 1); }
+        }
+
+        unsigned int solutions = solver.countSolutions(puzzle, SOLUTION_LIMIT);
+        for (unsigned int move = 0; move < MAX_MOVES && solutions > 1; move++) {
+            const unsigned int cell = clue_cells[random.below(clue_cells.size())];
+            const auto &units       = Tables::CELL_UNITS[cell];
+
+            // The cell's own digit is in all three masks, so it is never picked again
+            uint16_t candidates = ~(used[units[0]] | used[units[1]] | used[units[2]]) & 0x1FF;
+            if (candidates == 0) { continue; }
+            for (unsigned int skip = random.below(std::popcount(candidates)); skip > 0; skip--) {
+                candidates &= candidates - 1;
+            }
+
+            const uint16_t bit     = candidates & -candidates;
+            const uint8_t previous = puzzle[cell];
+            puzzle[cell]           = std::countr_zero(bit) + 1;
+            stats.moves++;
+
+            // Counting past the current number is wasted work, unless the walk is still on the
+            // plateau where every filling hits the limit
+            const unsigned int limit = solutions < SOLUTION_LIMIT ? solutions + 1 : SOLUTION_LIMIT;
+            const unsigned int count = solver.countSolutions(puzzle, limit);
+            if (count == 0 || count > solutions) {
+                stats.rejected += count == 0;
+                puzzle[cell] = previous;
+                continue;
+            }
+
+            const uint16_t change = (1 << (previous - 1)) | bit;
+            for (unsigned int unit : units) { used[unit] ^= change; }
+            solutions = count;
+        }
+
+        if (solutions == 1) { return true; }
+    }
+
+    return false;
+}
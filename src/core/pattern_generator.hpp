@@ -0,0 +1,97 @@
+#ifndef PATTERN_GENERATOR_HPP
+#define PATTERN_GENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "board.hpp"
+#include "grid_generator.hpp"
+#include "packed_board.hpp"
+#include "random.hpp"
+#include "solver.hpp"
+#include "tables.hpp"
+#include "thread_pool.hpp"
+
+// Cells that hold a clue
+using ClueMask = BoardTables<3, 3>::Set;
+
+// No puzzle with fewer clues has a unique solution
+static constexpr unsigned int MIN_PATTERN_CLUES = 17;
+
+enum Symmetry {
+    SYMMETRY_NONE,
+    // 180 degree rotation around the center cell
+    SYMMETRY_ROTATIONAL,
+    // Left to right around the middle column
+    SYMMETRY_MIRROR,
+    // Across the main diagonal
+    SYMMETRY_DIAGONAL,
+    SYMMETRY_COUNT,
+};
+
+const char *getSymmetryName(Symmetry symmetry);
+// Returns `SYMMETRY_COUNT` for an unknown name
+Symmetry parseSymmetry(const char *name);
+
+// Random mask of exactly `clues` cells that maps onto itself under `symmetry`
+ClueMask makeClueMask(Random &random, unsigned int clues, Symmetry symmetry);
+// The non-zero cells of `cells`, so any puzzle line can serve as a template
+ClueMask getClueMask(const Cells &cells);
+
+struct PatternStats {
+    // Random grids the search started from
+    uint64_t fillings = 0;
+    // Clue changes tried, and the ones that left no solution at all
+    uint64_t moves    = 0;
+    uint64_t rejected = 0;
+};
+
+// Makes puzzles whose clues sit exactly on a given mask.
+//
+// A filling of the mask is the set of digits on its cells. The search starts from the mask cells
+// of a random complete grid, which always has a solution, and walks from there by changing one
+// clue at a time. Every cell keeps its candidates through the used digits of its units, updated
+// on every change, so a move never puts two equal clues in a unit. The solver then counts the
+// solutions of the new filling, stopping as soon as there are more than before, and the move is
+// kept when the count did not grow. Its singles propagation throws out most fillings without
+// any solution before the first branch. A filling with a single solution is a puzzle. After
+// `MAX_MOVES` moves the walk starts over from a new grid.
+//
+// Throughput depends on the mask as much as on its clue count: random rotational masks with 30
+// clues give 100 to 170 thousand puzzles per minute on one core, with 24 clues anywhere from
+// none to ten thousand. Masks without any puzzle use up `MAX_FILLINGS` fillings per attempt.
+class PatternGenerator {
+public:
+    explicit PatternGenerator(unsigned int threads = 0);
+
+    // Puzzle `i` comes from `Random(seed, i)` so a seed gives the same puzzles on any number of
+    // threads. Only the puzzles that were found end up in `puzzles`, returns their count.
+    size_t generate(const ClueMask &mask,
+                    size_t count,
+                    uint64_t seed,
+                    std::vector<PackedBoard> &puzzles);
+
+    // Added up over all calls until `resetStats`
+    const PatternStats &getStats() const;
+    void resetStats();
+    ThreadPool &getPool();
+
+    // Single puzzle on the calling thread, returns whether one was found
+    static bool generateOne(Random &random,
+                            const ClueMask &mask,
+                            const GridGenerator &grids,
+                            Solver<3, 3> &solver,
+                            Cells &puzzle,
+                            PatternStats &stats);
+
+private:
+    static constexpr unsigned int MAX_FILLINGS   = 16;
+    static constexpr unsigned int MAX_MOVES      = 512;
+    static constexpr unsigned int SOLUTION_LIMIT = 16;
+
+    ThreadPool pool;
+    PatternStats stats;
+};
+
+#endif // PATTERN_GENERATOR_HPP
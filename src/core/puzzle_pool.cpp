@@ -0,0 +1,169 @@
+#include "puzzle_pool.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "generator.hpp"
+#include "logical_solver.hpp"
+#include "puzzle_reader.hpp"
+#include "solver.hpp"
+
+PuzzlePool::PuzzlePool(size_t watermark): watermark(watermark) { }
+
+PuzzlePool::~PuzzlePool() { this->stop(); }
+
+bool PuzzlePool::load(const char *path) {
+    if (!std::filesystem::exists(path)) { return true; }
+
+    std::ifstream input(path);
+    if (!input) {
+        std::cerr << "Failed to open '" << path << "'" << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    Solver<3, 3> solver;
+    std::string line;
+    size_t line_number = 0;
+    while (std::getline(input, line)) {
+        line_number++;
+        // A pool edited on Windows keeps its CRLF line endings
+        if (!line.empty() && line.back() == '\r') { line.pop_back(); }
+        if (line.empty() || line[0] == '#') { continue; }
+
+        // The difficulty follows the digits after a single space
+        Cells cells;
+        unsigned int difficulty = DIFFICULTY_COUNT;
+        if (line.size() > 9 * 9 + 1 && parseCells(line.c_str(), cells)) {
+            const char *name = line.c_str() + 9 * 9 + 1;
+            for (difficulty = 0; difficulty < DIFFICULTY_COUNT; difficulty++) {
+                if (std::strcmp(name, getDifficultyName(Difficulty(difficulty))) == 0) { break; }
+            }
+        }
+
+        if (difficulty == DIFFICULTY_COUNT) {
+            std::cerr << "Failed to parse line " << line_number << " of '" << path << "'"
+                      << std::endl;
+            continue;
+        }
+
+        // Same cap as the worker, the rest of an oversized file is dropped unchecked
+        if (this->tiers[difficulty].size() >= this->watermark) { continue; }
+
+        // An edited or corrupt pool must not hand out a game that cannot be finished
+        if (solver.countSolutions(cells, 2) != 1) {
+            std::cerr << "Failed to load line " << line_number << " of '" << path
+                      << "': the puzzle has no unique solution" << std::endl;
+            continue;
+        }
+
+        packCells(cells, this->tiers[difficulty].emplace_back());
+    }
+
+    return true;
+}
+
+bool PuzzlePool::save(const char *path) const {
+    const std::string temporary = std::string(path) + ".tmp";
+    std::ofstream output(temporary);
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        output << "# Puzzles ready for the next games, regenerated when deleted\n";
+        for (unsigned int difficulty = 0; difficulty < DIFFICULTY_COUNT; difficulty++) {
+            for (const PackedBoard &packed : this->tiers[difficulty]) {
+                Cells cells;
+                unpackCells(packed, cells);
+                for (uint8_t digit : cells) { output << char('0' + digit); }
+                output << ' ' << getDifficultyName(Difficulty(difficulty)) << '\n';
+            }
+        }
+    }
+
+    output.close();
+    if (!output || std::rename(temporary.c_str(), path) != 0) {
+        std::cerr << "Failed to save the puzzle pool to '" << path << "'" << std::endl;
+        std::remove(temporary.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void PuzzlePool::start() {
+    if (this->worker.joinable()) { return; }
+
+    this->stopping = false;
+    const uint64_t seed = (uint64_t(std::random_device()()) << 32) | std::random_device()();
+    this->worker        = std::thread(&PuzzlePool::run, this, seed);
+}
+
+void PuzzlePool::stop() {
+    if (!this->worker.joinable()) { return; }
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+
+    this->wake.notify_one();
+    this->worker.join();
+}
+
+bool PuzzlePool::isRunning() const { return this->worker.joinable(); }
+
+bool PuzzlePool::pop(Difficulty difficulty, PackedBoard &puzzle) {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        std::vector<PackedBoard> &tier = this->tiers[difficulty];
+        if (tier.empty()) { return false; }
+
+        puzzle = tier.back();
+        tier.pop_back();
+    }
+
+    this->wake.notify_one();
+    return true;
+}
+
+size_t PuzzlePool::getSize(Difficulty difficulty) const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->tiers[difficulty].size();
+}
+
+bool PuzzlePool::isFull() const {
+    for (const std::vector<PackedBoard> &tier : this->tiers) {
+        if (tier.size() < this->watermark) { return false; }
+    }
+
+    return true;
+}
+
+void PuzzlePool::run(uint64_t seed) {
+    Solver<3, 3> solver;
+    LogicalSolver logical;
+    GeneratorStats stats;
+    Cells puzzle;
+
+    for (uint64_t index = 0;; index++) {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->wake.wait(lock, [&] { return this->stopping || !this->isFull(); });
+            if (this->stopping) { return; }
+        }
+
+        // Generating and rating take milliseconds, so they run without holding the lock
+        Random random(seed, index);
+        PuzzleGenerator::generateOne(random, 0, solver, puzzle, stats);
+        const Rating rating = ratePuzzle(logical, puzzle);
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        std::vector<PackedBoard> &tier = this->tiers[rating.difficulty];
+        if (tier.size() < this->watermark) { packCells(puzzle, tier.emplace_back()); }
+    }
+}
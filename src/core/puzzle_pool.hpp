@@ -0,0 +1,58 @@
+#ifndef PUZZLE_POOL_HPP
+#define PUZZLE_POOL_HPP
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "difficulty.hpp"
+#include "packed_board.hpp"
+
+// Ready puzzles for every difficulty tier, so starting a game never waits for the generator.
+//
+// A background thread generates minimal puzzles, rates them and keeps every tier topped up to
+// the watermark, then sleeps until a puzzle is taken. Puzzles for full tiers are dropped, every
+// tier gets at least a few percent of the generated puzzles. The pool is saved on exit and
+// loaded on the next start, so even the first game of a run comes out of it.
+class PuzzlePool {
+public:
+    static constexpr size_t DEFAULT_WATERMARK = 16;
+
+    explicit PuzzlePool(size_t watermark = DEFAULT_WATERMARK);
+    ~PuzzlePool();
+
+    // Adds the puzzles saved by `save`. A missing file is an empty pool, not an error. Lines
+    // without exactly one solution are reported and skipped, tiers stop at the watermark.
+    bool load(const char *path);
+    // One `<81 digits> <difficulty>` line per puzzle, so the file also reads as a puzzle file.
+    // Written next to `path` first and renamed over it, an interrupted save keeps the old pool.
+    bool save(const char *path) const;
+
+    // Starts the background thread, every start draws a new seed so runs do not repeat puzzles
+    void start();
+    // Waits for the puzzle in progress to finish
+    void stop();
+    bool isRunning() const;
+
+    // Takes a puzzle of `difficulty` in constant time, returns false when the tier is empty
+    bool pop(Difficulty difficulty, PackedBoard &puzzle);
+    size_t getSize(Difficulty difficulty) const;
+
+private:
+    size_t watermark;
+    std::array<std::vector<PackedBoard>, DIFFICULTY_COUNT> tiers;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::thread worker;
+    bool stopping = false;
+
+    bool isFull() const;
+    void run(uint64_t seed);
+};
+
+#endif // PUZZLE_POOL_HPP
@@ -0,0 +1,170 @@
+#include "puzzle_reader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <immintrin.h>
+
+#include "cpu_features.hpp"
+#include "kernels.hpp"
+
+PuzzleReader::PuzzleReader(size_t buffer_size): buffer(buffer_size) { }
+
+PuzzleReader::~PuzzleReader() { this->close(); }
+
+bool PuzzleReader::open(const char *path) {
+    this->close();
+
+    this->file = std::strcmp(path, "-") == 0 ? stdin : std::fopen(path, "rb");
+    if (!this->file) {
+        std::cerr << "Failed to open puzzle file '" << path << "'" << std::endl;
+        return false;
+    }
+
+    this->data = this->buffer.data();
+    return true;
+}
+
+void PuzzleReader::openBuffer(const char *data, size_t size) {
+    this->close();
+
+    this->data = data;
+    this->end  = size;
+}
+
+void PuzzleReader::close() {
+    if (this->file && this->file != stdin) { std::fclose(this->file); }
+
+    this->file        = nullptr;
+    this->data        = nullptr;
+    this->begin       = 0;
+    this->end         = 0;
+    this->line_number = 0;
+}
+
+ReadStatus PuzzleReader::next(Cells &cells) {
+    while (true) {
+        const char *line     = this->data + this->begin;
+        const size_t left    = this->end - this->begin;
+        const char *line_end = (const char *)std::memchr(line, '\n', left);
+        if (!line_end) {
+            if (this->fill()) { continue; }
+            if (left == 0) { return READ_END; }
+
+            // Last line without a newline
+            line_end = line + left;
+        }
+
+        size_t length = line_end - line;
+        this->begin   = std::min<size_t>(this->begin + length + 1, this->end);
+        this->line_number++;
+
+        if (length > 0 && line[length - 1] == '\r') { length--; }
+        if (length == 0 || line[0] == '#') { continue; }
+
+        if (length < cells.size() || !Kernels::get().parseCells(line, cells)) {
+            this->reportInvalid(line, length);
+            return READ_INVALID;
+        }
+
+        return READ_OK;
+    }
+}
+
+size_t PuzzleReader::getLineNumber() const { return this->line_number; }
+
+// Moves the unread part of the buffer to the front and reads more after it. Returns false when
+// there is nothing left to read.
+bool PuzzleReader::fill() {
+    if (!this->file) { return false; }
+
+    const size_t left = this->end - this->begin;
+    std::memmove(this->buffer.data(), this->buffer.data() + this->begin, left);
+    this->begin = 0;
+    this->end   = left;
+
+    // A single line filling the whole buffer
+    if (left == this->buffer.size()) { this->buffer.resize(this->buffer.size() * 2); }
+    this->data = this->buffer.data();
+
+    const size_t read = std::fread(this->buffer.data() + left, 1, this->buffer.size() - left,
+                                   this->file);
+    this->end += read;
+    return read > 0;
+}
+
+void PuzzleReader::reportInvalid(const char *line, size_t length) const {
+    std::cerr << "Invalid puzzle on line " << this->line_number << ": ";
+    if (length < 9 * 9) {
+        std::cerr << "expected 81 cells, found " << length << std::endl;
+        return;
+    }
+
+    size_t column = 0;
+    while (line[column] == '.' || (line[column] >= '0' && line[column] <= '9')) { column++; }
+    std::cerr << "unexpected character '" << line[column] << "' in column " << column + 1
+              << std::endl;
+}
+
+bool parseCells(const char *text, Cells &cells) { return Kernels::get().parseCells(text, cells); }
+
+bool parseCellsScalar(const char *text, Cells &cells) {
+    for (unsigned int i = 0; i < 9 * 9; i++) {
+        const char c = text[i];
+        if (c == '.') {
+            cells[i] = 0;
+        } else if (c >= '0' && c <= '9') {
+            cells[i] = c - '0';
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Converts 16 characters, returns the mask of the valid ones
+TARGET_SSE42 static inline unsigned int parseChunk(const char *text, uint8_t *cells) {
+    const __m128i v      = _mm_loadu_si128((const __m128i *)text);
+    const __m128i digits = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+    const __m128i dots   = _mm_cmpeq_epi8(v, _mm_set1_epi8('.'));
+
+    // Characters below '0' wrap around and fail the unsigned range check as well
+    const __m128i in_range = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+    _mm_storeu_si128((__m128i *)cells, _mm_andnot_si128(dots, digits));
+
+    return _mm_movemask_epi8(_mm_or_si128(in_range, dots));
+}
+
+static inline bool parseLastCell(const char *text, Cells &cells) {
+    const char c = text[80];
+    cells[80]    = c == '.' ? 0 : c - '0';
+    return c == '.' || (c >= '0' && c <= '9');
+}
+
+TARGET_SSE42 bool parseCellsSse42(const char *text, Cells &cells) {
+    unsigned int valid = 0xFFFF;
+    for (unsigned int chunk = 0; chunk < 5; chunk++) {
+        valid &= parseChunk(text + chunk * 16, &cells[chunk * 16]);
+    }
+
+    return valid == 0xFFFF && parseLastCell(text, cells);
+}
+
+TARGET_AVX2 bool parseCellsAvx2(const char *text, Cells &cells) {
+    uint32_t valid = 0xFFFFFFFF;
+    for (unsigned int half = 0; half < 2; half++) {
+        const __m256i v      = _mm256_loadu_si256((const __m256i *)(text + half * 32));
+        const __m256i digits = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+        const __m256i dots   = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('.'));
+        const __m256i in_range =
+            _mm256_cmpeq_epi8(_mm256_min_epu8(digits, _mm256_set1_epi8(9)), digits);
+        _mm256_storeu_si256((__m256i *)&cells[half * 32], _mm256_andnot_si256(dots, digits));
+
+        valid &= _mm256_movemask_epi8(_mm256_or_si256(in_range, dots));
+    }
+
+    return valid == 0xFFFFFFFF && parseChunk(text + 64, &cells[64]) == 0xFFFF
+        && parseLastCell(text, cells);
+}
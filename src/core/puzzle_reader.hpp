@@ -0,0 +1,60 @@
+#ifndef PUZZLE_READER_HPP
+#define PUZZLE_READER_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#include "board.hpp"
+
+enum ReadStatus {
+    READ_OK,
+    READ_INVALID,
+    READ_END,
+};
+
+// Streams puzzles in the common text format: one 81 character line per puzzle with `0` or `.`
+// for empty cells. Anything after the 81st character is ignored, empty lines and lines starting
+// with `#` are skipped. Lines are parsed straight out of a large read buffer (or out of memory
+// owned by the caller), so reading never allocates per line.
+class PuzzleReader {
+public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+    explicit PuzzleReader(size_t buffer_size = DEFAULT_BUFFER_SIZE);
+    ~PuzzleReader();
+
+    // `-` reads from standard input
+    bool open(const char *path);
+    // Reads from `data` directly, which must outlive the reader
+    void openBuffer(const char *data, size_t size);
+    void close();
+
+    // Parses the next puzzle into `cells`. Malformed lines are reported with their line number
+    // and return READ_INVALID, so callers can keep their output aligned with the input.
+    ReadStatus next(Cells &cells);
+
+    // Line of the last puzzle returned by `next`, starting from 1
+    size_t getLineNumber() const;
+
+private:
+    std::FILE *file = nullptr;
+    std::vector<char> buffer;
+    const char *data   = nullptr;
+    size_t begin       = 0;
+    size_t end         = 0;
+    size_t line_number = 0;
+
+    bool fill();
+    void reportInvalid(const char *line, size_t length) const;
+};
+
+// Parses exactly 81 characters, returns false if any of them is not a digit or `.`. Uses the
+// kernel selected by `Kernels`.
+bool parseCells(const char *text, Cells &cells);
+
+bool parseCellsScalar(const char *text, Cells &cells);
+bool parseCellsSse42(const char *text, Cells &cells);
+bool parseCellsAvx2(const char *text, Cells &cells);
+
+#endif // PUZZLE_READER_HPP
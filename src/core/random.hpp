@@ -0,0 +1,51 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <cstdint>
+#include <utility>
+
+// xoshiro256** seeded through splitmix64. Small and fast enough to give every generated puzzle
+// its own stream: `Random(seed, index)` depends only on its arguments, so output stays the same
+// no matter how work is split between threads.
+class Random {
+public:
+    explicit Random(uint64_t seed, uint64_t stream = 0) {
+        uint64_t state = seed ^ (stream * 0xD1B54A32D192ED03);
+        for (uint64_t &word : this->state) { word = splitMix(state); }
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotate(this->state[1] * 5, 7) * 9;
+        const uint64_t t      = this->state[1] << 17;
+
+        this->state[2] ^= this->state[0];
+        this->state[3] ^= this->state[1];
+        this->state[1] ^= this->state[2];
+        this->state[0] ^= this->state[3];
+        this->state[2] ^= t;
+        this->state[3] = rotate(this->state[3], 45);
+        return result;
+    }
+
+    // In `[0, bound)`, off from uniform by at most `bound / 2^32`. Bound must be positive.
+    uint32_t below(uint32_t bound) { return ((this->next() >> 32) * bound) >> 32; }
+
+    template <typename T>
+    void shuffle(T *items, uint32_t count) {
+        for (uint32_t i = count; i > 1; i--) { std::swap(items[i - 1], items[this->below(i)]); }
+    }
+
+private:
+    uint64_t state[4];
+
+    static uint64_t rotate(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    static uint64_t splitMix(uint64_t &state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15);
+        z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+        z          = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+        return z ^ (z >> 31);
+    }
+};
+
+#endif // RANDOM_HPP
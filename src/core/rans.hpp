@@ -0,0 +1,66 @@
+#ifndef RANS_HPP
+#define RANS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Byte-wise rANS entropy coder with 12-bit frequencies. Decoding a symbol is a mask, a table
+// lookup and a multiply, without divisions or hard to predict branches. Symbols are encoded in
+// reverse order, so the decoder reads them front to back.
+static constexpr unsigned int RANS_SCALE_BITS = 12;
+static constexpr uint32_t RANS_TOTAL          = 1 << RANS_SCALE_BITS;
+static constexpr uint32_t RANS_LOW            = 1 << 23;
+
+class RansEncoder {
+public:
+    // Encodes the symbol covering `[start, start + freq)` of `RANS_TOTAL`
+    void put(uint32_t start, uint32_t freq) {
+        const uint32_t max = ((RANS_LOW >> RANS_SCALE_BITS) << 8) * freq;
+        while (this->state >= max) {
+            this->bytes.push_back(this->state & 0xFF);
+            this->state >>= 8;
+        }
+
+        this->state = ((this->state / freq) << RANS_SCALE_BITS) + this->state % freq + start;
+    }
+
+    // Appends the stream to `output`, ready for `RansDecoder`
+    void flush(std::vector<uint8_t> &output) {
+        for (unsigned int i = 0; i < 4; i++) { this->bytes.push_back(this->state >> (24 - i * 8)); }
+        output.insert(output.end(), this->bytes.rbegin(), this->bytes.rend());
+
+        this->bytes.clear();
+        this->state = RANS_LOW;
+    }
+
+private:
+    uint32_t state = RANS_LOW;
+    std::vector<uint8_t> bytes;
+};
+
+class RansDecoder {
+public:
+    // Reading past `size` yields zeros, so corrupt input decodes to garbage instead of crashing
+    RansDecoder(const uint8_t *data, size_t size): data(data), size(size) {
+        for (unsigned int i = 0; i < 4; i++) { this->state |= uint32_t(this->next()) << (i * 8); }
+    }
+
+    // Position of the next symbol in `[0, RANS_TOTAL)`, the caller looks up which one it is
+    uint32_t peek() const { return this->state & (RANS_TOTAL - 1); }
+
+    void advance(uint32_t start, uint32_t freq) {
+        this->state = freq * (this->state >> RANS_SCALE_BITS) + this->peek() - start;
+        while (this->state < RANS_LOW) { this->state = (this->state << 8) | this->next(); }
+    }
+
+private:
+    const uint8_t *data;
+    size_t size;
+    size_t position = 0;
+    uint32_t state  = 0;
+
+    uint8_t next() { return this->position < this->size ? this->data[this->position++] : 0; }
+};
+
+#endif // RANS_HPP
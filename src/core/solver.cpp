@@ -0,0 +1,8 @@
+#include "solver.hpp"
+
+template class Solver<2, 2>;
+template class Solver<2, 3>;
+template class Solver<3, 3>;
+template class Solver<3, 4>;
+template class Solver<4, 4>;
+template class Solver<5, 5>;
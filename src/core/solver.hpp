@@ -0,0 +1,272 @@
+#ifndef SOLVER_HPP
+#define SOLVER_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "board.hpp"
+#include "tables.hpp"
+
+struct SolverStats {
+    uint64_t nodes      = 0;
+    uint64_t backtracks = 0;
+};
+
+// Backtracking solver that keeps a "used digits" mask for every row, column and box.
+// Candidates of a cell are the digits missing from all three of its masks. Naked and hidden
+// singles are propagated before branching on the cell with the fewest candidates.
+// Everything is constexpr, so puzzles can also be solved and checked at compile time.
+template <unsigned int BoxRows, unsigned int BoxCols>
+class Solver {
+public:
+    using Geometry = BoardGeometry<BoxRows, BoxCols>;
+    using Cells    = typename Geometry::Cells;
+    using Mask     = typename Geometry::Mask;
+
+    constexpr bool solve(const Cells &puzzle);
+    constexpr unsigned int countSolutions(const Cells &puzzle, unsigned int limit);
+
+    // Propagates singles on `puzzle` and splits it on the cell with the fewest candidates, one
+    // child per candidate. Returns false on a contradiction. A puzzle solved by propagation
+    // alone yields no children and becomes the solution.
+    constexpr bool branch(const Cells &puzzle, std::vector<Cells> &children);
+
+    // The search gives up as soon as `stop` becomes true
+    constexpr void setStopFlag(const std::atomic<bool> *stop);
+
+    constexpr const Cells &getSolution() const;
+    constexpr const SolverStats &getStats() const;
+
+private:
+    using Tables = BoardTables<BoxRows, BoxCols>;
+
+    static constexpr unsigned int NO_CELL = Geometry::CELL_COUNT;
+
+    struct State {
+        Cells cells;
+        std::array<Mask, Geometry::UNIT_COUNT> used;
+        unsigned int empty;
+    };
+
+    Cells solution = {};
+    SolverStats stats;
+    unsigned int solution_count   = 0;
+    unsigned int solution_limit   = 0;
+    const std::atomic<bool> *stop = nullptr;
+
+    constexpr bool load(State &state, const Cells &puzzle) const;
+    constexpr bool place(State &state, unsigned int cell, unsigned int digit) const;
+    constexpr Mask candidates(const State &state, unsigned int cell) const;
+    constexpr bool propagate(State &state, unsigned int &branch_cell) const;
+    constexpr void search(State &state);
+    constexpr unsigned int run(const Cells &puzzle, unsigned int limit);
+};
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+constexpr bool Solver<BoxRows, BoxCols>::solve(const Cells &puzzle) {
+    return this->run(puzzle, 1) == 1;
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+constexpr unsigned int Solver<BoxRows, BoxCols>::countSolutions(const Cells &puzzle,
+                                                                unsigned int limit) {
+    return this->run(puzzle, limit);
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+constexpr bool Solver<BoxRows, BoxCols>::branch(const Cells &puzzle,
+                                                std::vector<Cells> &children) {
+    this->stats = {};
+    children.clear();
+
+    State state;
+    unsigned int cell;
+    if (!this->load(state, puzzle) || !this->propagate(state, cell)) { return false; }
+
+    if (cell == NO_CELL) {
+        this->solution = state.cells;
+        return true;
+    }
+
+    Mask cand = this->candidates(state, cell);
+    while (cand) {
+        const Mask bit = cand & -cand;
+        cand ^= bit;
+
+        Cells child = state.cells;
+        child[cell] = std::countr_zero(bit) + 1;
+        children.push_back(child);
+    }
+
+    return true;
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+constexpr void Solver<BoxRows, BoxCols>::setStopFlag(const std::atomic<bool> *stop) {
+    this->stop = stop;
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+constexpr const typename Solver<BoxRows, BoxCols>::Cells &
+Solver<BoxRows, BoxCols>::getSolution() const {
+    return this->solution;
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+constexpr const SolverStats &Solver<BoxRows, BoxCols>::getStats() const {
+    return this->stats;
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+constexpr bool Solver<BoxRows, BoxCols>::load(State &state, const Cells &puzzle) const {
+    state.cells = {};
+    state.used  = {};
+    state.empty = Geometry::CELL_COUNT;
+
+    for (unsigned int i = 0; i < Geometry::CELL_COUNT; i++) {
+        if (puzzle[i] == 0) { continue; }
+        if (puzzle[i] > Geometry::SIZE || !this->place(state, i, puzzle[i])) { return false; }
+    }
+
+    return true;
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+constexpr bool Solver<BoxRows, BoxCols>::place(State &state,
+                                               unsigned int cell,
+                                               unsigned int digit) const {
+    const Mask bit    = Mask(1) << (digit - 1);
+    const auto &units = Tables::CELL_UNITS[cell];
+    if ((state.used[units[0]] | state.used[units[1]] | state.used[units[2]]) & bit) {
+        return false;
+    }
+
+    state.cells[cell] = digit;
+    state.used[units[0]] |= bit;
+    state.used[units[1]] |= bit;
+    state.used[units[2]] |= bit;
+    state.empty--;
+    return true;
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+constexpr typename Solver<BoxRows, BoxCols>::Mask
+Solver<BoxRows, BoxCols>::candidates(const State &state, unsigned int cell) const {
+    const auto &units = Tables::CELL_UNITS[cell];
+    const Mask used   = state.used[units[0]] | state.used[units[1]] | state.used[units[2]];
+    return ~used & Geometry::ALL_DIGITS;
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+constexpr bool Solver<BoxRows, BoxCols>::propagate(State &state, unsigned int &branch_cell) const {
+    bool changed = true;
+    while (changed && state.empty > 0) {
+        changed                 = false;
+        branch_cell             = NO_CELL;
+        unsigned int best_count = Geometry::SIZE + 1;
+
+        // Naked singles: cells with exactly one candidate left
+        for (unsigned int i = 0; i < Geometry::CELL_COUNT; i++) {
+            if (state.cells[i] != 0) { continue; }
+
+            const Mask cand = this->candidates(state, i);
+            if (cand == 0) { return false; }
+
+            const unsigned int count = std::popcount(cand);
+            if (count == 1) {
+                this->place(state, i, std::countr_zero(cand) + 1);
+                changed = true;
+            } else if (count < best_count) {
+                best_count  = count;
+                branch_cell = i;
+            }
+        }
+
+        if (changed) { continue; }
+
+        // Hidden singles: digits that fit in only one cell of a unit
+        for (unsigned int unit = 0; unit < Geometry::UNIT_COUNT; unit++) {
+            Mask once = 0, twice = 0;
+            for (unsigned int cell : Tables::UNIT_CELLS[unit]) {
+                if (state.cells[cell] != 0) { continue; }
+
+                const Mask cand = this->candidates(state, cell);
+                twice |= once & cand;
+                once |= cand;
+            }
+
+            if ((once | state.used[unit]) != Geometry::ALL_DIGITS) { return false; }
+
+            Mask hidden = once & ~twice;
+            while (hidden) {
+                const Mask bit = hidden & -hidden;
+                hidden ^= bit;
+
+                for (unsigned int cell : Tables::UNIT_CELLS[unit]) {
+                    if (state.cells[cell] != 0 || !(this->candidates(state, cell) & bit)) {
+                        continue;
+                    }
+
+                    if (!this->place(state, cell, std::countr_zero(bit) + 1)) { return false; }
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (state.empty == 0) { branch_cell = NO_CELL; }
+    return true;
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+constexpr void Solver<BoxRows, BoxCols>::search(State &state) {
+    if (this->stop && this->stop->load(std::memory_order_relaxed)) { return; }
+    this->stats.nodes++;
+
+    unsigned int cell;
+    if (!this->propagate(state, cell)) {
+        this->stats.backtracks++;
+        return;
+    }
+
+    if (cell == NO_CELL) {
+        if (this->solution_count++ == 0) { this->solution = state.cells; }
+        return;
+    }
+
+    Mask cand = this->candidates(state, cell);
+    while (cand && this->solution_count < this->solution_limit) {
+        const Mask bit = cand & -cand;
+        cand ^= bit;
+
+        State next = state;
+        this->place(next, cell, std::countr_zero(bit) + 1);
+        this->search(next);
+    }
+}
+
+template <unsigned int BoxRows, unsigned int BoxCols>
+constexpr unsigned int Solver<BoxRows, BoxCols>::run(const Cells &puzzle, unsigned int limit) {
+    this->stats          = {};
+    this->solution_count = 0;
+    this->solution_limit = limit;
+
+    State state;
+    if (limit == 0 || !this->load(state, puzzle)) { return 0; }
+
+    this->search(state);
+    return this->solution_count;
+}
+
+extern template class Solver<2, 2>;
+extern template class Solver<2, 3>;
+extern template class Solver<3, 3>;
+extern template class Solver<3, 4>;
+extern template class Solver<4, 4>;
+extern template class Solver<5, 5>;
+
+#endif // SOLVER_HPP
@@ -0,0 +1,99 @@
+#ifndef TABLES_HPP
+#define TABLES_HPP
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include "cell_set.hpp"
+#include "geometry.hpp"
+
+// Lookup tables generated at compile time, so the hot paths never divide by the board size.
+// Units are numbered with rows first, then columns and boxes, e.g. rows 0-8, columns 9-17 and
+// boxes 18-26 on a 9x9 board. Peers of a cell are the other cells sharing a unit with it.
+template <unsigned int BoxRows, unsigned int BoxCols>
+struct BoardTables {
+    using Geometry = BoardGeometry<BoxRows, BoxCols>;
+    using Index    = std::conditional_t<(Geometry::CELL_COUNT <= 256), uint8_t, uint16_t>;
+    using Set      = CellSet<Geometry::CELL_COUNT>;
+
+    static constexpr unsigned int SIZE       = Geometry::SIZE;
+    static constexpr unsigned int CELL_COUNT = Geometry::CELL_COUNT;
+    static constexpr unsigned int UNIT_COUNT = Geometry::UNIT_COUNT;
+    static constexpr unsigned int PEER_COUNT = 2 * (SIZE - 1) + (SIZE - BoxRows - BoxCols + 1);
+
+    static constexpr std::array<uint8_t, CELL_COUNT> CELL_ROW = [] {
+        std::array<uint8_t, CELL_COUNT> result = {};
+        for (unsigned int i = 0; i < CELL_COUNT; i++) { result[i] = Geometry::row(i); }
+        return result;
+    }();
+
+    static constexpr std::array<uint8_t, CELL_COUNT> CELL_COLUMN = [] {
+        std::array<uint8_t, CELL_COUNT> result = {};
+        for (unsigned int i = 0; i < CELL_COUNT; i++) { result[i] = Geometry::column(i); }
+        return result;
+    }();
+
+    static constexpr std::array<uint8_t, CELL_COUNT> CELL_BOX = [] {
+        std::array<uint8_t, CELL_COUNT> result = {};
+        for (unsigned int i = 0; i < CELL_COUNT; i++) { result[i] = Geometry::box(i); }
+        return result;
+    }();
+
+    static constexpr std::array<std::array<uint8_t, 3>, CELL_COUNT> CELL_UNITS = [] {
+        std::array<std::array<uint8_t, 3>, CELL_COUNT> result = {};
+        for (unsigned int i = 0; i < CELL_COUNT; i++) {
+            result[i][0] = CELL_ROW[i];
+            result[i][1] = SIZE + CELL_COLUMN[i];
+            result[i][2] = 2 * SIZE + CELL_BOX[i];
+        }
+        return result;
+    }();
+
+    // Cells of every unit in row-major order
+    static constexpr std::array<std::array<Index, SIZE>, UNIT_COUNT> UNIT_CELLS = [] {
+        std::array<std::array<Index, SIZE>, UNIT_COUNT> result = {};
+        std::array<unsigned int, UNIT_COUNT> sizes             = {};
+        for (unsigned int i = 0; i < CELL_COUNT; i++) {
+            for (unsigned int unit : CELL_UNITS[i]) { result[unit][sizes[unit]++] = i; }
+        }
+        return result;
+    }();
+
+    static constexpr std::array<Set, UNIT_COUNT> UNIT_MASKS = [] {
+        std::array<Set, UNIT_COUNT> result = {};
+        for (unsigned int unit = 0; unit < UNIT_COUNT; unit++) {
+            for (unsigned int cell : UNIT_CELLS[unit]) { result[unit].set(cell); }
+        }
+        return result;
+    }();
+
+    static constexpr std::array<Set, CELL_COUNT> PEER_MASKS = [] {
+        std::array<Set, CELL_COUNT> result = {};
+        for (unsigned int i = 0; i < CELL_COUNT; i++) {
+            for (unsigned int unit : CELL_UNITS[i]) { result[i] |= UNIT_MASKS[unit]; }
+            result[i].reset(i);
+        }
+        return result;
+    }();
+
+    // Peers of every cell in ascending order
+    static constexpr std::array<std::array<Index, PEER_COUNT>, CELL_COUNT> PEERS = [] {
+        std::array<std::array<Index, PEER_COUNT>, CELL_COUNT> result = {};
+        for (unsigned int i = 0; i < CELL_COUNT; i++) {
+            unsigned int count = 0;
+            for (unsigned int peer = 0; peer < CELL_COUNT; peer++) {
+                if (PEER_MASKS[i].test(peer)) { result[i][count++] = peer; }
+            }
+        }
+        return result;
+    }();
+};
+
+static_assert(BoardTables<3, 3>::PEER_COUNT == 20);
+
+inline constexpr const auto &CELL_UNITS = BoardTables<3, 3>::CELL_UNITS;
+inline constexpr const auto &UNIT_CELLS = BoardTables<3, 3>::UNIT_CELLS;
+inline constexpr const auto &PEERS      = BoardTables<3, 3>::PEERS;
+
+#endif // TABLES_HPP
@@ -0,0 +1,163 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+thread_local ThreadPool *ThreadPool::current_pool     = nullptr;
+thread_local unsigned int ThreadPool::current_worker = ThreadPool::NO_WORKER;
+thread_local unsigned int ThreadPool::running_tasks  = 0;
+
+ThreadPool::ThreadPool(unsigned int threads) {
+    if (threads == 0) { threads = std::max(1u, std::thread::hardware_concurrency()); }
+
+    for (unsigned int i = 0; i < threads; i++) {
+        this->workers.push_back(std::make_unique<Worker>());
+    }
+    for (unsigned int i = 0; i < threads; i++) {
+        this->threads.emplace_back(&ThreadPool::run, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(this->sleep_mutex);
+        this->stopping = true;
+    }
+    this->wake.notify_all();
+
+    for (std::thread &thread : this->threads) { thread.join(); }
+}
+
+unsigned int ThreadPool::getThreadCount() const { return this->workers.size(); }
+
+unsigned int ThreadPool::getWorkerIndex() const {
+    return current_pool == this && current_worker != NO_WORKER ? current_worker
+                                                               : this->workers.size();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    const unsigned int index = current_pool == this && current_worker != NO_WORKER
+                                 ? current_worker
+                                 : this->next++ % this->workers.size();
+
+    this->pending++;
+    {
+        std::lock_guard<std::mutex> lock(this->workers[index]->mutex);
+        this->workers[index]->tasks.push_back(std::move(task));
+    }
+    this->queued++;
+
+    // Taking the lock orders the notification after a sleeping worker's predicate check
+    { std::lock_guard<std::mutex> lock(this->sleep_mutex); }
+    this->wake.notify_one();
+}
+
+void ThreadPool::submit(TaskGroup &group, std::function<void()> task) {
+    group++;
+    this->submit([&group, task = std::move(task)] {
+        task();
+        group--;
+    });
+}
+
+void ThreadPool::wait() {
+    // The running task counts as pending itself, so this would never return
+    assert(running_tasks == 0 && "ThreadPool::wait called from a task, use a TaskGroup");
+
+    while (this->pending > 0) {
+        if (!this->runOne()) { std::this_thread::yield(); }
+    }
+}
+
+void ThreadPool::wait(const TaskGroup &group) {
+    while (group > 0) {
+        if (!this->runOne()) { std::this_thread::yield(); }
+    }
+}
+
+void ThreadPool::parallelFor(size_t count,
+                             size_t chunk,
+                             const std::function<void(size_t begin, size_t end)> &body) {
+    chunk = std::max<size_t>(chunk, 1);
+
+    TaskGroup group = 0;
+    for (size_t begin = 0; begin < count; begin += chunk) {
+        const size_t end = std::min(begin + chunk, count);
+        this->submit(group, [&body, begin, end] { body(begin, end); });
+    }
+
+    this->wait(group);
+}
+
+void ThreadPool::run(unsigned int index) {
+    current_pool   = this;
+    current_worker = index;
+
+    while (true) {
+        if (this->runOne()) { continue; }
+
+        std::unique_lock<std::mutex> lock(this->sleep_mutex);
+        this->wake.wait(lock, [this] { return this->stopping || this->queued > 0; });
+        if (this->stopping && this->queued == 0) { break; }
+    }
+}
+
+bool ThreadPool::runOne() {
+    const unsigned int index = current_pool == this ? current_worker : NO_WORKER;
+
+    std::function<void()> task;
+    if ((index == NO_WORKER || !this->pop(index, task)) && !this->steal(index, task)) {
+        return false;
+    }
+
+    this->queued--;
+    running_tasks++;
+    task();
+    running_tasks--;
+    this->pending--;
+    return true;
+}
+
+bool ThreadPool::pop(unsigned int index, std::function<void()> &task) {
+    Worker &worker = *this->workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) { return false; }
+
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(unsigned int thief, std::function<void()> &task) {
+    const unsigned int count = this->workers.size();
+    const unsigned int start = thief == NO_WORKER ? this->next.load() : thief + 1;
+
+    for (unsigned int i = 0; i < count; i++) {
+        const unsigned int victim = (start + i) % count;
+        if (victim == thief) { continue; }
+
+        // Take the older half of the victim's tasks, keep one and move the rest to our deque
+        std::deque<std::function<void()>> stolen;
+        {
+            std::lock_guard<std::mutex> lock(this->workers[victim]->mutex);
+            auto &tasks = this->workers[victim]->tasks;
+            if (tasks.empty()) { continue; }
+
+            const size_t take = thief == NO_WORKER ? 1 : (tasks.size() + 1) / 2;
+            std::move(tasks.begin(), tasks.begin() + take, std::back_inserter(stolen));
+            tasks.erase(tasks.begin(), tasks.begin() + take);
+        }
+
+        task = std::move(stolen.front());
+        stolen.pop_front();
+        if (!stolen.empty()) {
+            std::lock_guard<std::mutex> lock(this->workers[thief]->mutex);
+            auto &tasks = this->workers[thief]->tasks;
+            std::move(stolen.begin(), stolen.end(), std::back_inserter(tasks));
+        }
+
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,72 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool. Every worker owns a deque: it pops its own work from the back and idle
+// workers steal half of another worker's deque from the front. Threads that wait for work they
+// submitted run queued tasks in the meantime. Tasks may submit more work and wait for it through
+// a `TaskGroup`, but never with the pool-wide `wait`, which would wait for themselves.
+class ThreadPool {
+public:
+    // Unfinished tasks submitted with the group, so every caller waits only for its own work
+    using TaskGroup = std::atomic<size_t>;
+
+    explicit ThreadPool(unsigned int threads = 0);
+    ~ThreadPool();
+
+    unsigned int getThreadCount() const;
+    // Index of the calling worker, `getThreadCount()` on threads outside the pool. Lets tasks
+    // keep per-worker state in an array with one extra slot for the waiting caller.
+    unsigned int getWorkerIndex() const;
+
+    void submit(std::function<void()> task);
+    void submit(TaskGroup &group, std::function<void()> task);
+    // Waits for every task of the pool, only from threads that are not running a task
+    void wait();
+    // Waits for the tasks of `group`, from any thread
+    void wait(const TaskGroup &group);
+
+    // Runs `body(begin, end)` over `[0, count)` in chunks of at most `chunk` and returns when all
+    // of them are done.
+    void parallelFor(size_t count,
+                     size_t chunk,
+                     const std::function<void(size_t begin, size_t end)> &body);
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    static constexpr unsigned int NO_WORKER = ~0u;
+    static thread_local ThreadPool *current_pool;
+    static thread_local unsigned int current_worker;
+    // Tasks running on this thread, nested ones included
+    static thread_local unsigned int running_tasks;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    std::atomic<size_t> queued     = 0;
+    std::atomic<size_t> pending    = 0;
+    std::atomic<unsigned int> next = 0;
+    bool stopping                  = false;
+
+    void run(unsigned int index);
+    bool runOne();
+    bool pop(unsigned int index, std::function<void()> &task);
+    bool steal(unsigned int thief, std::function<void()> &task);
+};
+
+#endif // THREAD_POOL_HPP
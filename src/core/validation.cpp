@@ -0,0 +1,195 @@
+#include "validation.hpp"
+
+#include <cstring>
+
+#include <immintrin.h>
+
+#include "cpu_features.hpp"
+#include "kernels.hpp"
+#include "tables.hpp"
+
+bool findConflicts(const Cells &cells, UnitConflicts &conflicts) {
+    Kernels::get().findConflicts(cells, conflicts);
+
+    uint16_t any = 0;
+    for (uint16_t conflict : conflicts) { any |= conflict; }
+    return any == 0;
+}
+
+void findConflictsScalar(const Cells &cells, UnitConflicts &conflicts) {
+    std::array<uint16_t, 3 * 9> seen = {};
+    conflicts                        = {};
+
+    for (unsigned int i = 0; i < 9 * 9; i++) {
+        // Values above 9 are not digits, like in the vector kernels
+        const uint16_t bit = cells[i] <= 9 ? (1 << cells[i]) >> 1 : 0;
+        for (unsigned int unit : CELL_UNITS[i]) {
+            conflicts[unit] |= seen[unit] & bit;
+            seen[unit] |= bit;
+        }
+    }
+}
+
+// Every row of the board is loaded into its own register with the digits of a column sharing a
+// byte lane. Column duplicates are found by accumulating the rows vertically. Box duplicates use
+// the same accumulation on "box lines": line `j` holds the `j`th cell of every box, lane `b`
+// being box `b`, assembled from the rows with byte shuffles. Row duplicates are found inside
+// each register with a prefix OR over the lanes.
+TARGET_SSE42 static inline void loadRows(const Cells &cells, __m128i (&rows)[9]) {
+    const __m128i keep = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0);
+    for (unsigned int r = 0; r < 8; r++) {
+        rows[r] = _mm_and_si128(_mm_loadu_si128((const __m128i *)&cells[r * 9]), keep);
+    }
+
+    // A full load of the last row would read past the end of the board
+    alignas(16) uint8_t last[16] = {};
+    std::memcpy(last, &cells[8 * 9], 9);
+    rows[8] = _mm_load_si128((const __m128i *)last);
+
+    // Values above 9 become empty cells, the digit mask lookups would wrap them around
+    const __m128i nine = _mm_set1_epi8(9);
+    for (__m128i &row : rows) {
+        row = _mm_and_si128(row, _mm_cmpeq_epi8(_mm_min_epu8(row, nine), row));
+    }
+}
+
+// Shuffle controls moving cell `j % 3` of every box of band `b` into lanes `b * 3` to `b * 3 + 2`
+static constexpr auto BOX_LINE_SHUFFLES = [] {
+    std::array<std::array<std::array<int8_t, 16>, 3>, 3> result = {};
+    for (unsigned int band = 0; band < 3; band++) {
+        for (unsigned int column = 0; column < 3; column++) {
+            result[band][column].fill(-1);
+            for (unsigned int stack = 0; stack < 3; stack++) {
+                result[band][column][band * 3 + stack] = stack * 3 + column;
+            }
+        }
+    }
+    return result;
+}();
+
+TARGET_SSE42 static inline void loadBoxLines(const __m128i (&rows)[9], __m128i (&lines)[9]) {
+    for (unsigned int j = 0; j < 9; j++) {
+        __m128i line = _mm_setzero_si128();
+        for (unsigned int band = 0; band < 3; band++) {
+            const __m128i shuffle =
+                _mm_loadu_si128((const __m128i *)BOX_LINE_SHUFFLES[band][j % 3].data());
+            line = _mm_or_si128(line, _mm_shuffle_epi8(rows[band * 3 + j / 3], shuffle));
+        }
+        lines[j] = line;
+    }
+}
+
+// Turns digits into 16-bit digit masks, lanes 0-7 go to `low` and lane 8 to the first lane of
+// `high`.
+TARGET_SSE42 static inline void digitBits(__m128i digits, __m128i &low, __m128i &high) {
+    const __m128i low_table  = _mm_setr_epi8(0, 1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i high_table = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+
+    const __m128i lo = _mm_shuffle_epi8(low_table, digits);
+    const __m128i hi = _mm_shuffle_epi8(high_table, digits);
+    low              = _mm_unpacklo_epi8(lo, hi);
+    high             = _mm_unpackhi_epi8(lo, hi);
+}
+
+TARGET_SSE42 static inline uint16_t rowDuplicates(__m128i low, __m128i high) {
+    __m128i prefix = _mm_or_si128(low, _mm_slli_si128(low, 2));
+    prefix         = _mm_or_si128(prefix, _mm_slli_si128(prefix, 4));
+    prefix         = _mm_or_si128(prefix, _mm_slli_si128(prefix, 8));
+
+    // Every lane meets the OR of the lanes before it, lane 8 meets all of the first eight
+    __m128i dup = _mm_and_si128(low, _mm_slli_si128(prefix, 2));
+    dup         = _mm_or_si128(dup, _mm_and_si128(high, _mm_srli_si128(prefix, 14)));
+    dup         = _mm_or_si128(dup, _mm_srli_si128(dup, 8));
+    dup         = _mm_or_si128(dup, _mm_srli_si128(dup, 4));
+    dup         = _mm_or_si128(dup, _mm_srli_si128(dup, 2));
+    return _mm_extract_epi16(dup, 0);
+}
+
+TARGET_SSE42 void findConflictsSse42(const Cells &cells, UnitConflicts &conflicts) {
+    __m128i rows[9], lines[9];
+    loadRows(cells, rows);
+    loadBoxLines(rows, lines);
+
+    __m128i seen[2][2] = {}, dup[2][2] = {};
+    for (unsigned int j = 0; j < 9; j++) {
+        __m128i low, high;
+
+        digitBits(rows[j], low, high);
+        conflicts[j] = rowDuplicates(low, high);
+        dup[0][0]    = _mm_or_si128(dup[0][0], _mm_and_si128(seen[0][0], low));
+        dup[0][1]    = _mm_or_si128(dup[0][1], _mm_and_si128(seen[0][1], high));
+        seen[0][0]   = _mm_or_si128(seen[0][0], low);
+        seen[0][1]   = _mm_or_si128(seen[0][1], high);
+
+        digitBits(lines[j], low, high);
+        dup[1][0]  = _mm_or_si128(dup[1][0], _mm_and_si128(seen[1][0], low));
+        dup[1][1]  = _mm_or_si128(dup[1][1], _mm_and_si128(seen[1][1], high));
+        seen[1][0] = _mm_or_si128(seen[1][0], low);
+        seen[1][1] = _mm_or_si128(seen[1][1], high);
+    }
+
+    _mm_storeu_si128((__m128i *)&conflicts[9], dup[0][0]);
+    conflicts[17] = _mm_extract_epi16(dup[0][1], 0);
+    _mm_storeu_si128((__m128i *)&conflicts[18], dup[1][0]);
+    conflicts[26] = _mm_extract_epi16(dup[1][1], 0);
+}
+
+TARGET_AVX2 void findConflictsAvx2(const Cells &cells, UnitConflicts &conflicts) {
+    __m128i rows[9], lines[9];
+    loadRows(cells, rows);
+    loadBoxLines(rows, lines);
+
+    __m256i seen_columns = _mm256_setzero_si256(), dup_columns = _mm256_setzero_si256();
+    __m256i seen_boxes = _mm256_setzero_si256(), dup_boxes = _mm256_setzero_si256();
+    for (unsigned int j = 0; j < 9; j++) {
+        __m128i low, high;
+
+        digitBits(rows[j], low, high);
+        conflicts[j] = rowDuplicates(low, high);
+
+        const __m256i columns = _mm256_set_m128i(high, low);
+        dup_columns  = _mm256_or_si256(dup_columns, _mm256_and_si256(seen_columns, columns));
+        seen_columns = _mm256_or_si256(seen_columns, columns);
+
+        digitBits(lines[j], low, high);
+
+        const __m256i boxes = _mm256_set_m128i(high, low);
+        dup_boxes  = _mm256_or_si256(dup_boxes, _mm256_and_si256(seen_boxes, boxes));
+        seen_boxes = _mm256_or_si256(seen_boxes, boxes);
+    }
+
+    // Columns are stored first, the spill past lane 8 is overwritten by the boxes
+    alignas(32) uint16_t boxes[16];
+    _mm256_storeu_si256((__m256i *)&conflicts[9], dup_columns);
+    _mm256_store_si256((__m256i *)boxes, dup_boxes);
+    std::memcpy(&conflicts[18], boxes, 9 * sizeof(uint16_t));
+}
+
+TARGET_AVX512 void findConflictsAvx512(const Cells &cells, UnitConflicts &conflicts) {
+    __m128i rows[9], lines[9];
+    loadRows(cells, rows);
+    loadBoxLines(rows, lines);
+
+    // A row and a box line share one register, 16 lanes each, and digit masks come straight
+    // from a variable shift instead of table lookups.
+    const __m512i ones = _mm512_set1_epi16(1);
+    __m512i seen       = _mm512_setzero_si512();
+    __m512i dup        = _mm512_setzero_si512();
+    for (unsigned int j = 0; j < 9; j++) {
+        const __m512i digits = _mm512_cvtepu8_epi16(_mm256_set_m128i(lines[j], rows[j]));
+        const __m512i bits   = _mm512_maskz_sllv_epi16(
+            _mm512_test_epi16_mask(digits, digits), ones, _mm512_sub_epi16(digits, ones));
+
+        dup  = _mm512_or_si512(dup, _mm512_and_si512(seen, bits));
+        seen = _mm512_or_si512(seen, bits);
+
+        __m128i low, high;
+        digitBits(rows[j], low, high);
+        conflicts[j] = rowDuplicates(low, high);
+    }
+
+    alignas(64) uint16_t result[32];
+    _mm512_store_si512(result, dup);
+    std::memcpy(&conflicts[9], &result[0], 9 * sizeof(uint16_t));
+    std::memcpy(&conflicts[18], &result[16], 9 * sizeof(uint16_t));
+}
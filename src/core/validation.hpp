@@ -0,0 +1,21 @@
+#ifndef VALIDATION_HPP
+#define VALIDATION_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "board.hpp"
+
+// Mask of the digits that appear more than once in every unit, see `UNIT_CELLS` for the order
+using UnitConflicts = std::array<uint16_t, 3 * 9>;
+
+// Validates all 27 units at once with the kernel selected by `Kernels`. Returns true when the
+// board has no conflicts. Values above 9 are not digits, every kernel treats them as empty cells.
+bool findConflicts(const Cells &cells, UnitConflicts &conflicts);
+
+void findConflictsScalar(const Cells &cells, UnitConflicts &conflicts);
+void findConflictsSse42(const Cells &cells, UnitConflicts &conflicts);
+void findConflictsAvx2(const Cells &cells, UnitConflicts &conflicts);
+void findConflictsAvx512(const Cells &cells, UnitConflicts &conflicts);
+
+#endif // VALIDATION_HPP
@@ -1,31 +1,56 @@
 #include "game.hpp"
 
-#include <algorithm>
-
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <mutex>
 
+#include "core/builtin_puzzles.hpp"
+#include "core/puzzle_reader.hpp"
 #include "resource_manager.hpp"
 
-Game::Game(int width, int height): width(width), height(height) {
-    for (size_t i = 0; i < this->numbers.size(); i++) {
-        this->numbers[i].type   = NUMBER_CHANGABLE;
-        this->numbers[i].number = 0;
-    }
-}
+Game::Game(int width, int height, size_t pool_watermark)
+    : width(width), height(height), pool(pool_watermark) { }
 
 Game::~Game() {
+    if (this->pool.isRunning()) {
+        this->pool.stop();
+        this->pool.save(POOL_PATH);
+    }
+
     delete this->camera;
     delete this->grid;
     delete this->selection_box;
 
     ResourceManager::clear();
 
-    glDeleteVertexArrays(1, &this->errorVAO);
-    glDeleteBuffers(1, &this->errorVBO);
-    glDeleteBuffers(1, &this->errorEBO);
+    // Nothing was created when the window never opened, e.g. in `--solve` mode
+    if (this->errorVAO) {
+        glDeleteVertexArrays(1, &this->errorVAO);
+        glDeleteBuffers(1, &this->errorVBO);
+        glDeleteBuffers(1, &this->errorEBO);
+    }
+}
+
+bool Game::loadPuzzles(const char *path) {
+    PuzzleReader reader;
+    if (!reader.open(path)) { return false; }
+
+    std::vector<PackedBoard> puzzles;
+    Cells cells;
+    ReadStatus status;
+    while ((status = reader.next(cells)) != READ_END) {
+        if (status == READ_OK) { packCells(cells, puzzles.emplace_back()); }
+    }
+
+    if (puzzles.empty()) {
+        std::cerr << "Failed to find any puzzle in '" << path << "'" << std::endl;
+        return false;
+    }
+
+    this->puzzles      = std::move(puzzles);
+    this->puzzle_index = 0;
+    return true;
 }
 
 void Game::init() {
@@ -61,6 +86,13 @@ void Game::init() {
     glEnableVertexAttribArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
+
+    if (this->puzzles.empty()) {
+        this->pool.load(POOL_PATH);
+        this->pool.start();
+    }
+
+    this->newGame();
 }
 
 void Game::update() {
@@ -77,8 +109,8 @@ void Game::draw() const {
 
     // Draw numbers on the grid
     auto font = ResourceManager::getFont("open_sans");
-    for (size_t i = 0; i < this->numbers.size(); i++) {
-        const Number &cell = this->numbers[i];
+    for (unsigned int i = 0; i < 9 * 9; i++) {
+        const Number &cell = this->board.get(i);
 
         if (cell.number > 0) {
             font->renderChar(this->camera,
@@ -107,17 +139,19 @@ void Game::processInput(int key, int action) {
         this->selected = this->selected - (this->selected % 9) + (this->selected + 1) % 9;
         this->selection_box->updateModel(this->selected);
     } else if (key >= GLFW_KEY_0 && key <= GLFW_KEY_9 && action == GLFW_PRESS) {
-        auto &cell = this->numbers[this->selected];
-        if (cell.type != NUMBER_FIXED) { cell.number = key - '0'; }
-        this->updateErrors();
+        this->setNumber(key - '0');
     } else if (key >= GLFW_KEY_KP_0 && key <= GLFW_KEY_KP_9 && action == GLFW_PRESS) {
-        auto &cell = this->numbers[this->selected];
-        if (cell.type != NUMBER_FIXED) { cell.number = key - GLFW_KEY_KP_0; }
-        this->updateErrors();
+        this->setNumber(key - GLFW_KEY_KP_0);
     } else if (key == GLFW_KEY_BACKSPACE && action == GLFW_PRESS) {
-        auto &cell = this->numbers[this->selected];
-        if (cell.type != NUMBER_FIXED) { cell.number = 0; }
-        this->updateErrors();
+        this->setNumber(0);
+    } else if (key == GLFW_KEY_N && action == GLFW_PRESS) {
+        const size_t count = this->puzzles.empty() ? getBuiltinPuzzleCount() : this->puzzles.size();
+        this->puzzle_index = (this->puzzle_index + 1) % count;
+        this->newGame();
+    } else if (key == GLFW_KEY_D && action == GLFW_PRESS) {
+        this->difficulty = Difficulty((this->difficulty + 1) % DIFFICULTY_COUNT);
+        std::cout << "Difficulty: " << getDifficultyName(this->difficulty) << std::endl;
+        this->newGame();
     } else {
         std::cout << "key: " << key << ", action: " << action << std::endl;
     }
@@ -131,114 +165,24 @@ void Game::updateScreenSize(int width, int height) {
 
 const glm::vec4 &Game::getBackgroundColor() const { return this->background_color; }
 
-void Game::updateErrors() {
-    std::unique_lock<std::shared_mutex> error_lock(this->error_mutex, std::defer_lock);
-
-    // check the errors already in the vector still valid
-    for (size_t i = 0; i < this->error_count;) {
-        Error *err = &this->errors[i];
-        if (err->number == 0) {
-            i++;
-            continue;
-        }
-
-        if (err->type == ERROR_ROW) {
-            if (unsigned int error = this->checkRow(err->index)) {
-                err->number = error;
-                i++;
-            } else {
-                (void)std::remove(this->errors.begin(), this->errors.end(), *err);
-                this->error_count--;
-            }
-        } else if (err->type == ERROR_COLUMN) {
-            if (unsigned int error = this->checkColumn(err->index)) {
-                i++;
-                err->number = error;
-            } else {
-                (void)std::remove(this->errors.begin(), this->errors.end(), *err);
-                this->error_count--;
-            }
-        } else if (err->type == ERROR_BOX) {
-            if (unsigned int error = this->checkBox(err->index)) {
-                i++;
-                err->number = error;
-            } else {
-                (void)std::remove(this->errors.begin(), this->errors.end(), *err);
-                this->error_count--;
-            }
-        }
-    }
-
-    // Check for new errors
-    const unsigned int row = this->selected / 9;
-    if (unsigned int error = this->checkRow(row)) {
-        Error new_err = {ERROR_ROW, row, error};
-        if (std::find(this->errors.begin(), this->errors.end(), new_err) == this->errors.end())
-            this->errors[this->error_count++] = new_err;
-    }
-
-    const unsigned int column = this->selected % 9;
-    if (unsigned int error = this->checkColumn(column)) {
-        Error new_err = {ERROR_COLUMN, column, error};
-        if (std::find(this->errors.begin(), this->errors.end(), new_err) == this->errors.end())
-            this->errors[this->error_count++] = new_err;
-    }
-
-    const unsigned int box = (this->selected / 9) / 3 * 3 + (this->selected % 9) / 3;
-    if (unsigned int error = this->checkBox(box)) {
-        Error new_err = {ERROR_BOX, box, error};
-        if (std::find(this->errors.begin(), this->errors.end(), new_err) == this->errors.end())
-            this->errors[this->error_count++] = new_err;
-    }
-}
-
-unsigned int Game::checkRow(unsigned int row) const {
-    int found_numbers = 0;
-    for (unsigned int i = row * 9; i < row * 9 + 9; i++) {
-        if (this->numbers[i].number == 0) { continue; }
-
-        int n = 1 << (this->numbers[i].number - 1);
-        if (found_numbers & n) {
-            return this->numbers[i].number;
-        } else {
-            found_numbers |= n;
-        }
-    }
-
-    return 0;
-}
-
-unsigned int Game::checkColumn(unsigned int column) const {
-    int found_numbers = 0;
-    for (unsigned int i = column; i < 81; i += 9) {
-        if (this->numbers[i].number == 0) { continue; }
-
-        int n = 1 << (this->numbers[i].number - 1);
-        if (found_numbers & n) {
-            return this->numbers[i].number;
-        } else {
-            found_numbers |= n;
-        }
+void Game::newGame() {
+    std::unique_lock<std::shared_mutex> error_lock(this->error_mutex);
+    PackedBoard packed;
+    if (!this->puzzles.empty()) {
+        unpackBoard(this->puzzles[this->puzzle_index], this->board);
+    } else if (this->pool.pop(this->difficulty, packed)) {
+        unpackBoard(packed, this->board);
+    } else {
+        // The pool starts out empty on the very first run, and a tier can be taken empty
+        std::cout << "No " << getDifficultyName(this->difficulty)
+                  << " puzzle ready yet, loaded a built-in puzzle" << std::endl;
+        this->board.load(getBuiltinPuzzle(this->puzzle_index).puzzle);
     }
-
-    return 0;
 }
 
-unsigned int Game::checkBox(unsigned int box) const {
-    int found_numbers = 0;
-    for (unsigned int i = 0; i < 9; i++) {
-        unsigned int index = (box / 3) * 27 + (box % 3) * 3 + (i / 3) * 9 + (i % 3);
-        if (this->numbers[index].number == 0) { continue; }
-
-        int n = 1 << (this->numbers[index].number - 1);
-        if (found_numbers & n) {
-            return this->numbers[index].number;
-        } else {
-            found_numbers |= n;
-        }
-    }
-
-    return 0;
+void Game::setNumber(unsigned int number) {
+    std::unique_lock<std::shared_mutex> error_lock(this->error_mutex, std::defer_lock);
+    this->board.set(this->selected, number);
 }
 
 void Game::drawErrors() const {
@@ -252,27 +196,14 @@ void Game::drawErrors() const {
 
     glBindVertexArray(errorVAO);
 
-    glm::mat4 scale;
-    glm::mat4 position;
-
-    for (size_t i = 0; i < this->error_count; i++) {
-        const Error &err = this->errors[i];
-
-        if (err.type == ERROR_ROW) {
-            scale    = glm::scale(glm::mat4(1.0f), glm::vec3(0.11f * 9, 0.11f, 1.0f));
-            position = glm::translate(glm::mat4(1.0f),
-                                      glm::vec3(0.0f, 1.0f - 0.22f * err.index - 0.12f, 0.0f));
-        } else if (err.type == ERROR_COLUMN) {
-            scale    = glm::scale(glm::mat4(1.0f), glm::vec3(0.11f, 0.11f * 9, 1.0f));
-            position = glm::translate(glm::mat4(1.0f),
-                                      glm::vec3(-1.0f + 0.22f * err.index + 0.12f, 0.0f, 0.0f));
-        } else if (err.type == ERROR_BOX) {
-            scale    = glm::scale(glm::mat4(1.0f), glm::vec3(0.11f * 3, 0.11f * 3, 1.0f));
-            position = glm::translate(glm::mat4(1.0f),
-                                      glm::vec3(-1.0f + 0.34f + 0.22f * 3 * (err.index % 3),
-                                                1.0f - 0.34f - 0.22f * 3 * (err.index / 3),
-                                                0.0f));
-        }
+    const glm::mat4 scale = glm::scale(glm::mat4(1.0f), glm::vec3(0.11f, 0.11f, 1.0f));
+
+    // Only the cells clashing with a peer are tinted
+    const auto &cells = this->board.getConflictCells();
+    for (unsigned int i = cells.next(0); i < 81; i = cells.next(i + 1)) {
+        const glm::mat4 position = glm::translate(
+            glm::mat4(1.0f),
+            glm::vec3(-1.0f + 0.22f * (i % 9) + 0.12f, 1.0f - 0.22f * (i / 9) - 0.12f, 0.0f));
 
         shader->setUniform("model", position * scale);
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
@@ -6,43 +6,20 @@
 #include <vector>
 
 #include "camera.hpp"
+#include "core/board.hpp"
+#include "core/difficulty.hpp"
+#include "core/packed_board.hpp"
+#include "core/puzzle_pool.hpp"
 #include "grid.hpp"
 #include "selection_box.hpp"
 
-enum NumberType {
-    NUMBER_FIXED,
-    NUMBER_CHANGABLE,
-    NUMBER_NOTE, // TODO: implement
-};
-
-struct Number {
-    NumberType type;
-    unsigned int number;
-};
-
-enum ErrorType {
-    ERROR_ROW,
-    ERROR_COLUMN,
-    ERROR_BOX,
-};
-
-struct Error {
-    ErrorType type;
-    unsigned int index;
-    unsigned int number;
-
-    bool operator==(const Error &e) const {
-        return type == e.type && index == e.index && number == e.number;
-    }
-
-    bool operator!=(const Error &e) const { return !(*this == e); }
-};
-
 class Game {
 public:
-    Game(int width, int height);
+    Game(int width, int height, size_t pool_watermark);
     ~Game();
 
+    // Replaces the built-in puzzles with the ones in `path`, see `PuzzleReader` for the format
+    bool loadPuzzles(const char *path);
     void init();
     void update();
     void draw() const;
@@ -52,13 +29,17 @@ public:
 
 private:
     int width, height;
-    unsigned int selected             = 0;
-    std::array<Number, 9 * 9> numbers = {};
+    unsigned int selected = 0;
+    size_t puzzle_index   = 0;
+    std::vector<PackedBoard> puzzles;
+    // Generated puzzles, used when no puzzle file was given
+    static constexpr const char *POOL_PATH = "puzzle_pool.txt";
+    PuzzlePool pool;
+    Difficulty difficulty = DIFFICULTY_MEDIUM;
+    Board<3, 3> board;
     mutable std::shared_mutex error_mutex;
-    size_t error_count                  = 0;
-    std::array<Error, 3 * 9 * 9> errors = {};
 
-    unsigned int errorVAO, errorVBO, errorEBO;
+    unsigned int errorVAO = 0, errorVBO = 0, errorEBO = 0;
     // clang-format off
     std::array<float, 2 * 4> error_vertices = {
         -1.0f, -1.0f,
@@ -90,10 +71,8 @@ private:
         return glm::vec4(r, g, b, a);
     }
 
-    void updateErrors();
-    unsigned int checkRow(unsigned int row) const;
-    unsigned int checkColumn(unsigned int column) const;
-    unsigned int checkBox(unsigned int box) const;
+    void newGame();
+    void setNumber(unsigned int number);
     void drawErrors() const;
 };
 
@@ -5,12 +5,15 @@
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 
+#include "core/commands.hpp"
 #include "game.hpp"
 
 #define START_WIDTH  800
 #define START_HEIGHT 600
+// Puzzles kept ready for every difficulty
+#define POOL_WATERMARK 16
 
-Game game(START_WIDTH, START_HEIGHT);
+Game game(START_WIDTH, START_HEIGHT, POOL_WATERMARK);
 
 static void error_callback(int error, const char *description) {
     std::cerr << " GLFW Error(" << error << "): " << description << std::endl;
@@ -29,7 +32,36 @@ void key_callback(GLFWwindow *window, int key, int scancode, int action, int mod
     game.processInput(key, action);
 }
 
-int main() {
+int main(int argc, char **argv) {
+    // Headless modes, they never touch GLFW or OpenGL
+    if (argc > 1 && std::strcmp(argv[1], "--solve") == 0) {
+        return runSolveCommand(argc - 2, argv + 2);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--corpus") == 0) {
+        return runCorpusCommand(argc - 2, argv + 2);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--archive") == 0) {
+        return runArchiveCommand(argc - 2, argv + 2);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--unarchive") == 0) {
+        return runUnarchiveCommand(argc - 2, argv + 2);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--rate") == 0) {
+        return runRateCommand(argc - 2, argv + 2);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--generate") == 0) {
+        return runGenerateCommand(argc - 2, argv + 2);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--grids") == 0) {
+        return runGridsCommand(argc - 2, argv + 2);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--pattern") == 0) {
+        return runPatternCommand(argc - 2, argv + 2);
+    }
+
+    // An optional puzzle file replaces the built-in puzzles
+    if (argc > 1 && !game.loadPuzzles(argv[1])) { return -1; }
+
     glfwSetErrorCallback(error_callback);
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW: " << strerror(errno) << std::endl;